@@ -2,11 +2,10 @@
 #define STARTASM_ASTBUILDER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
-#include <unordered_map>
 #include <utility>
 #include <regex>
-#include <functional>
 
 #include "pt/ParseTree.h"
 #include "ast/Instructions.h"
@@ -14,23 +13,18 @@
 
 class ASTBuilder {
 public:
-    ASTBuilder();
+    ASTBuilder() = default;
     ~ASTBuilder() = default;
     ASTBuilder(const ASTBuilder&) = delete;
     ASTBuilder& operator=(const ASTBuilder&) = delete;
 
     void buildAST(PT::PTNode* parseTree, AST::AbstractSyntaxTree* abstractSyntaxTree);
 
-private:
-    using InstructionFactory = std::function<AST::InstructionNode*(const std::string&, int)>;
-    std::unordered_map<ASTConstants::InstructionType, InstructionFactory> instructionFactoryMap;
+    //Node factories (also used by the parser's fused path to emit AST nodes directly)
+    //Nodes are allocated in the given arena (the calling thread's pool)
+    AST::InstructionNode* instructionBuilder(Arena& arena, ASTConstants::InstructionType nodeType, std::string_view value, int line) const;
+    AST::OperandNode* operandBuilder(Arena& arena, ASTConstants::OperandType nodeType, std::string_view value, int line, short int pos, const OperandValue& operandValue) const;
 
-    using OperandFactory = std::function<AST::OperandNode*(const std::string&, int line, short int pos)>;
-    std::unordered_map<ASTConstants::OperandType, OperandFactory> operandFactoryMap;
-
-    void initializeFactoryMaps();
-    AST::InstructionNode* instructionBuilder(ASTConstants::InstructionType nodeType, const std::string& value, int line);
-    AST::OperandNode* operandBuilder(ASTConstants::OperandType nodeType, const std::string& value, int line, short int pos);
 };
 
 #endif // STARTASM_ASTBUILDER_H
@@ -0,0 +1,11 @@
+#ifndef ASTCONSTANTS_H
+#define ASTCONSTANTS_H
+
+namespace ASTConstants {
+    enum NodeType {ROOT, INSTRUCTION, OPERAND};
+    enum InstructionType {MOVE, LOAD, STORE, CREATE, CAST, ADD, SUB, MULTIPLY, DIVIDE, OR, AND, NOT, SHIFT, COMPARE, JUMP, CALL, PUSH, POP, RETURN, STOP, INPUT, OUTPUT, PRINT, LABEL, COMMENT, NONE};
+    enum OperandType {REGISTER, INSTRUCTIONADDRESS, MEMORYADDRESS, INTEGER, FLOAT, BOOLEAN, CHARACTER, STRING, NEWLINE, TYPECONDITION, SHIFTCONDITION, JUMPCONDITION, UNKNOWN, EMPTY};
+    enum NumOperands {NULLARY, UNARY, BINARY, TERNARY, INVALID};
+};
+
+#endif
@@ -2,51 +2,66 @@
 #define ABSTRACTSYNTAXTREE_H
 
 #include <vector>
-#include <unordered_map>
 #include <algorithm>
 #include <string>
+#include <string_view>
 #include <iostream>
-#include <mutex>
 #include "pt/ParseTree.h"
-#include "Visitor.h"
+#include "ast/ASTConstants.h"
+#include "lang/OperandValue.h"
+#include "misc/Arena.h"
 
-namespace ASTConstants {
-    enum NodeType {ROOT, INSTRUCTION, OPERAND};
-    enum InstructionType {MOVE, LOAD, STORE, CREATE, CAST, ADD, SUB, MULTIPLY, DIVIDE, OR, AND, NOT, SHIFT, COMPARE, JUMP, CALL, PUSH, POP, RETURN, STOP, INPUT, OUTPUT, PRINT, LABEL, COMMENT, NONE};
-    enum OperandType {REGISTER, INSTRUCTIONADDRESS, MEMORYADDRESS, INTEGER, FLOAT, BOOLEAN, CHARACTER, STRING, NEWLINE, TYPECONDITION, SHIFTCONDITION, JUMPCONDITION, UNKNOWN, EMPTY};
-    enum NumOperands {NULLARY, UNARY, BINARY, TERNARY, INVALID};
-};
+//Stages that build the tree - the only code that may mutate its nodes
+class Parser;
+class ASTBuilder;
+class SymbolResolver;
 
 namespace AST {
-    class Visitor;
-
     // Broad AST Node
+    // Nodes live in their tree's arena and are never destroyed individually, so they hold no owning members - the
+    // node value is a view into the source (or static storage)
+    // Nodes are only mutated while their tree is being built, by the stages that build it (their mutators are private
+    // to everything else). Once the tree is frozen they are read-only, so they carry no locks and any number of
+    // threads may traverse them
+    // Nodes are not polymorphic - the node, instruction and operand type tags identify the concrete class, and
+    // visitors (Visitor.h) dispatch on them statically
     class ASTNode {
     public:
-        ASTNode(ASTConstants::NodeType type, const std::string &value);
-        virtual ~ASTNode();
+        ASTNode(ASTConstants::NodeType type, std::string_view value);
+        ~ASTNode() = default;
         ASTNode(const ASTNode&) = delete;
         ASTNode& operator=(const ASTNode&) = delete;
 
-        virtual void accept(Visitor& visitor) = 0;
-
         // Getters
-        std::string getNodeValue() const { return m_nodeValue; }
+        std::string getNodeValue() const { return std::string(m_nodeValue); }
+        std::string_view getNodeView() const { return m_nodeValue; }
         ASTConstants::NodeType getNodeType() const { return m_nodeType; }
-        int getNumChildren() const { return static_cast<int>(m_children.size()); }
-        const std::vector<ASTNode*>& getChildren() const { return m_children; }
-
-        // Setters
-        void setNodeValue(const std::string &value) { m_nodeValue = value; }
-        ASTNode* insertChild(ASTNode* childNode);
-        ASTNode* childAt(int index);
-        void reserveChildren(int numChildren);
 
     protected:
         ASTConstants::NodeType m_nodeType;
-        std::string m_nodeValue;
-        std::vector<ASTNode*> m_children;
-        mutable std::mutex m_mutex;
+        std::string_view m_nodeValue;
+    };
+
+    // Operand children stored inline in an instruction node (instructions never have more than three operands)
+    class OperandList {
+    public:
+        static constexpr int MAX_OPERANDS = 3;
+
+        ASTNode* const* begin() const { return m_operands; }
+        ASTNode* const* end() const { return m_operands + m_size; }
+        int size() const { return m_size; }
+        ASTNode* operator[](int index) const { return m_operands[index]; }
+        bool push_back(ASTNode* operand) {
+            if (m_size == MAX_OPERANDS) {
+                return false;
+            }
+            m_operands[m_size++] = operand;
+            return true;
+        }
+
+    private:
+        ASTNode* m_operands[MAX_OPERANDS] = {};
+        int m_size = 0;
     };
 
     // Specialized root node class (top level in AST)
@@ -54,28 +69,53 @@ namespace AST {
         friend class AST;
     public:
         RootNode();
-        ~RootNode() override;
+        ~RootNode();
         RootNode(const RootNode&) = delete;
         RootNode& operator=(const RootNode&) = delete;
 
-        void accept(Visitor& visitor) override;
+        int getNumChildren() const { return static_cast<int>(m_children.size()); }
+        const std::vector<ASTNode*>& getChildren() const { return m_children; }
+        ASTNode* childAt(int index) const;
+        bool isFrozen() const { return m_frozen; }
+
+    private:
+        friend class AbstractSyntaxTree;
+        friend class ::Parser;
+        friend class ::ASTBuilder;
+        void freeze() { m_frozen = true; }
+        // Instructions are inserted from a single thread, and are rejected once the tree is frozen
+        ASTNode* insertChild(ASTNode* childNode);
+        void reserveChildren(int numChildren);
+
+        std::vector<ASTNode*> m_children;
+        bool m_frozen = false;
     };
 
     // Template instruction node class
     class InstructionNode: public ASTNode {
     public:
-        InstructionNode(const std::string &nodeValue, ASTConstants::InstructionType instructionType, ASTConstants::NumOperands numOperands, int line);
-        ~InstructionNode() override;
+        InstructionNode(std::string_view nodeValue, ASTConstants::InstructionType instructionType, ASTConstants::NumOperands numOperands, int line);
+        ~InstructionNode();
         InstructionNode(const InstructionNode&) = delete;
         InstructionNode& operator=(const InstructionNode&) = delete;
 
         ASTConstants::InstructionType getInstructionType() const { return m_instructionType; }
         ASTConstants::NumOperands getNumOperands() const { return m_numOperands; }
         int getLine() const {return m_line; }
-        void setInstructionType(ASTConstants::InstructionType type) { m_instructionType = type; }
-        void setNumOperands(ASTConstants::NumOperands num) { m_numOperands = num; }
+
+        int getNumChildren() const { return m_children.size(); }
+        const OperandList& getChildren() const { return m_children; }
+        ASTNode* childAt(int index) const;
+
+    protected:
+        OperandList m_children;
 
     private:
+        friend class ::Parser;
+        friend class ::ASTBuilder;
+        // Operands are inserted by the thread building the instruction, before it is published to the root
+        ASTNode* insertChild(ASTNode* childNode);
+
         ASTConstants::InstructionType m_instructionType;
         ASTConstants::NumOperands m_numOperands;
         int m_line;
@@ -84,37 +124,48 @@ namespace AST {
     // Operand Node Class
     class OperandNode: public ASTNode {
     public:
-        OperandNode(const std::string &nodeValue, ASTConstants::OperandType operandType, int line, short int pos);
-        ~OperandNode() override;
+        OperandNode(std::string_view nodeValue, ASTConstants::OperandType operandType, int line, short int pos, const OperandValue &value);
+        ~OperandNode();
         OperandNode(const OperandNode&) = delete;
         OperandNode& operator=(const OperandNode&) = delete;
 
         ASTConstants::OperandType getOperandType() const { return m_operandType; }
         int getLine() const {return m_line; }
         short int getPos() const {return m_pos;}
-        void setOperandType(ASTConstants::OperandType type) { m_operandType = type; }
+        const OperandValue& getValue() const { return m_value; }
+        // Operand text for diagnostics and dumps - as written, or i[n] for a resolved label
+        std::string getOperandText() const;
 
     private:
+        friend class ::SymbolResolver;
+        // Symbol resolution fixes up a label operand's value before the tree is frozen
+        void setValue(const OperandValue &value) { m_value = value; }
+
         ASTConstants::OperandType m_operandType;
+        OperandValue m_value;
         int m_line;
         short int m_pos;
     };
 
-    // AST wrapper class
+    // AST wrapper class - owns the arena every node is allocated in, so dropping the tree is a single arena release
+    // The tree is built (parsing, AST building, symbol resolution), then frozen before any pass traverses it
     class AbstractSyntaxTree {
     public:
         AbstractSyntaxTree();
         ~AbstractSyntaxTree();
-        ASTNode* getRoot();
-        ASTConstants::InstructionType getInstructionType(const std::string &instruction);
+        RootNode* getRoot() const { return m_root; }
+        Arena& getArena() { return m_arena; }
+        // End the build phase - the tree is read-only from here on
+        void freeze() { m_root->freeze(); }
+        bool isFrozen() const { return m_root->isFrozen(); }
+        static ASTConstants::InstructionType getInstructionType(std::string_view instruction);
         ASTConstants::NumOperands getNumOperands(int num);
-        ASTConstants::OperandType convertOperandType(PTConstants::OperandType type);
+        static ASTConstants::OperandType convertOperandType(PTConstants::OperandType type);
         void printTree() const;
 
     private:
-        ASTNode* m_root;
-        std::unordered_map<std::string, ASTConstants::InstructionType> m_instructionDictionary;
-        mutable std::mutex m_mutex;
+        Arena m_arena;
+        RootNode* m_root;
         void printNode(const ASTNode* node, int level) const;
     };
 }
@@ -2,362 +2,45 @@
 #define INSTRUCTIONS_H
 
 #include "ast/AbstractSyntaxTree.h"
+#include "lang/InstructionSet.h"
 
 #include <string>
+#include <string_view>
 
 namespace AST {
-    class MoveInstruction : public InstructionNode {
-    public:
-        //Constructor - specifies num operands automatically
-        MoveInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::MOVE, ASTConstants::NumOperands::BINARY,
-                                  line) {}
-
-        //Accept method
-        void accept(Visitor &visitor) override {
-            //Iterate and visit for children first
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            //Visit for the instruction
-            visitor.visit(*this);
-        };
-    };
-
-    class LoadInstruction : public InstructionNode {
-    public:
-        LoadInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::LOAD, ASTConstants::NumOperands::BINARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class StoreInstruction : public InstructionNode {
-    public:
-        StoreInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::STORE, ASTConstants::NumOperands::BINARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class CreateInstruction : public InstructionNode {
-    public:
-        CreateInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::CREATE, ASTConstants::NumOperands::TERNARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class CastInstruction : public InstructionNode {
-    public:
-        CastInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::CAST, ASTConstants::NumOperands::BINARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class AddInstruction : public InstructionNode {
-    public:
-        AddInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::ADD, ASTConstants::NumOperands::TERNARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class SubInstruction : public InstructionNode {
-    public:
-        SubInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::SUB, ASTConstants::NumOperands::TERNARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class MultiplyInstruction : public InstructionNode {
-    public:
-        MultiplyInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::MULTIPLY,
-                                  ASTConstants::NumOperands::TERNARY, line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class DivideInstruction : public InstructionNode {
-    public:
-        DivideInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::DIVIDE, ASTConstants::NumOperands::TERNARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class OrInstruction : public InstructionNode {
-    public:
-        OrInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::OR, ASTConstants::NumOperands::BINARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class AndInstruction : public InstructionNode {
-    public:
-        AndInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::AND, ASTConstants::NumOperands::BINARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class NotInstruction : public InstructionNode {
-    public:
-        NotInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::NOT, ASTConstants::NumOperands::UNARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class ShiftInstruction : public InstructionNode {
-    public:
-        ShiftInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::SHIFT, ASTConstants::NumOperands::TERNARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class CompareInstruction : public InstructionNode {
-    public:
-        CompareInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::COMPARE, ASTConstants::NumOperands::BINARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class JumpInstruction : public InstructionNode {
-    public:
-        JumpInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::JUMP, ASTConstants::NumOperands::BINARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class CallInstruction : public InstructionNode {
-    public:
-        CallInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::CALL, ASTConstants::NumOperands::UNARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class PushInstruction : public InstructionNode {
-    public:
-        PushInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::PUSH, ASTConstants::NumOperands::UNARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class PopInstruction : public InstructionNode {
-    public:
-        PopInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::POP, ASTConstants::NumOperands::UNARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class ReturnInstruction : public InstructionNode {
-    public:
-        ReturnInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::RETURN, ASTConstants::NumOperands::NULLARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class StopInstruction : public InstructionNode {
-    public:
-        StopInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::STOP, ASTConstants::NumOperands::NULLARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class InputInstruction : public InstructionNode {
-    public:
-        InputInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::INPUT, ASTConstants::NumOperands::BINARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class OutputInstruction : public InstructionNode {
-    public:
-        OutputInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::OUTPUT, ASTConstants::NumOperands::UNARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class PrintInstruction : public InstructionNode {
-    public:
-        PrintInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::PRINT, ASTConstants::NumOperands::UNARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class LabelInstruction : public InstructionNode {
-    public:
-        LabelInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::LABEL, ASTConstants::NumOperands::UNARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
-
-    class CommentInstruction : public InstructionNode {
-    public:
-        CommentInstruction(const std::string &nodeValue, int line)
-                : InstructionNode(nodeValue, ASTConstants::InstructionType::COMMENT, ASTConstants::NumOperands::UNARY,
-                                  line) {}
-
-        void accept(Visitor &visitor) override {
-            for (auto* child : m_children) {
-                child->accept(visitor);
-            }
-            visitor.visit(*this);
-        };
-    };
+    //Instruction node of one opcode - its number of operands comes from the instruction set (visitors dispatch on
+    //the instruction type)
+    template <ASTConstants::InstructionType Type>
+    class Instruction : public InstructionNode {
+    public:
+        Instruction(std::string_view nodeValue, int line)
+                : InstructionNode(nodeValue, Type, InstructionSet::getNumOperands(Type), line) {}
+    };
+
+    using MoveInstruction = Instruction<ASTConstants::MOVE>;
+    using LoadInstruction = Instruction<ASTConstants::LOAD>;
+    using StoreInstruction = Instruction<ASTConstants::STORE>;
+    using CreateInstruction = Instruction<ASTConstants::CREATE>;
+    using CastInstruction = Instruction<ASTConstants::CAST>;
+    using AddInstruction = Instruction<ASTConstants::ADD>;
+    using SubInstruction = Instruction<ASTConstants::SUB>;
+    using MultiplyInstruction = Instruction<ASTConstants::MULTIPLY>;
+    using DivideInstruction = Instruction<ASTConstants::DIVIDE>;
+    using OrInstruction = Instruction<ASTConstants::OR>;
+    using AndInstruction = Instruction<ASTConstants::AND>;
+    using NotInstruction = Instruction<ASTConstants::NOT>;
+    using ShiftInstruction = Instruction<ASTConstants::SHIFT>;
+    using CompareInstruction = Instruction<ASTConstants::COMPARE>;
+    using JumpInstruction = Instruction<ASTConstants::JUMP>;
+    using CallInstruction = Instruction<ASTConstants::CALL>;
+    using PushInstruction = Instruction<ASTConstants::PUSH>;
+    using PopInstruction = Instruction<ASTConstants::POP>;
+    using ReturnInstruction = Instruction<ASTConstants::RETURN>;
+    using StopInstruction = Instruction<ASTConstants::STOP>;
+    using InputInstruction = Instruction<ASTConstants::INPUT>;
+    using OutputInstruction = Instruction<ASTConstants::OUTPUT>;
+    using PrintInstruction = Instruction<ASTConstants::PRINT>;
+    using LabelInstruction = Instruction<ASTConstants::LABEL>;
+    using CommentInstruction = Instruction<ASTConstants::COMMENT>;
 }
-#endif
\ No newline at end of file
+#endif
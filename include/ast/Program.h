@@ -0,0 +1,81 @@
+#ifndef PROGRAM_H
+#define PROGRAM_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "ast/ASTConstants.h"
+#include "lang/OperandValue.h"
+#include "lang/InstructionSet.h"
+#include "lexer/SourceManager.h"
+
+namespace AST {
+    //Dense structure-of-arrays form of a program, for analysis passes that don't need the node tree. There is one
+    //entry per source line (blank lines have opcode NONE), so entry n is instruction address i[n+1]. Operand fields
+    //hold MAX_OPERANDS slots per instruction, with unused slots left EMPTY
+    //Entries are independent, so different threads may fill different entries at the same time
+    class Program {
+    public:
+        static constexpr int MAX_OPERANDS = InstructionSet::MAX_OPERANDS;
+
+        Program() = default;
+        ~Program() = default;
+        //Delete copy and assignment
+        Program(const Program&) = delete;
+        Program& operator=(const Program&) = delete;
+
+        //Size for a number of lines, every entry blank
+        void resize(std::size_t numInstructions);
+
+        //Accessors
+        [[nodiscard]] std::size_t size() const { return m_opcodes.size(); }
+        [[nodiscard]] ASTConstants::InstructionType getOpcode(std::size_t index) const {
+            return static_cast<ASTConstants::InstructionType>(m_opcodes[index]);
+        }
+        [[nodiscard]] int getNumOperands(std::size_t index) const { return m_numOperands[index]; }
+        [[nodiscard]] int getLine(std::size_t index) const { return static_cast<int>(m_lines[index]); }
+        [[nodiscard]] ASTConstants::OperandType getOperandType(std::size_t index, int pos) const {
+            return static_cast<ASTConstants::OperandType>(m_operandTypes[index * MAX_OPERANDS + pos]);
+        }
+        [[nodiscard]] OperandValue getOperandValue(std::size_t index, int pos) const {
+            std::size_t slot = index * MAX_OPERANDS + pos;
+            return {m_payloads[slot], m_overflows[slot] != 0, m_textOffsets[slot] == FORMATTED_TEXT};
+        }
+        //Operand text as written (empty for a resolved label)
+        [[nodiscard]] std::string_view getOperandView(std::size_t index, int pos, const SourceManager& source) const;
+        //Operand text as written, or i[n] for a resolved label
+        [[nodiscard]] std::string getOperandText(std::size_t index, int pos, const SourceManager& source) const;
+        //Bytes held by the arrays
+        [[nodiscard]] std::size_t memoryUsage() const;
+
+        //Mutators
+        void setInstruction(std::size_t index, ASTConstants::InstructionType opcode, int line);
+        //Append an operand - its text is the given range of the instruction's source line
+        void addOperand(std::size_t index, ASTConstants::OperandType type, const OperandValue& value, uint32_t textOffset, uint32_t textLength);
+        //Point an operand at a resolved instruction address (its text becomes i[n])
+        void resolveAddress(std::size_t index, int pos, uint32_t address);
+
+        //Print in the same layout as AbstractSyntaxTree::printTree
+        void print(const SourceManager& source) const;
+
+    private:
+        //Marks operand text that is formatted from the payload rather than taken from the source
+        static constexpr uint32_t FORMATTED_TEXT = UINT32_MAX;
+
+        //Per instruction
+        std::vector<uint8_t> m_opcodes;
+        std::vector<uint8_t> m_numOperands;
+        std::vector<uint32_t> m_lines;
+        //Per operand slot
+        std::vector<uint8_t> m_operandTypes;
+        std::vector<OperandPayload> m_payloads;
+        std::vector<uint8_t> m_overflows;
+        std::vector<uint32_t> m_textOffsets;
+        std::vector<uint32_t> m_textLengths;
+    };
+}
+
+#endif
@@ -1,93 +1,223 @@
 #ifndef VISITOR_H
 #define VISITOR_H
 
+#include "ast/Instructions.h"
+#include "ast/Operands.h"
+
 namespace AST {
-    //AST root node forward declarations
-    class RootNode;
+    //Statically dispatched AST visitor (CRTP). A pass derives from Visitor<Pass>, brings the defaults into scope with
+    //`using Visitor<Pass>::visit;` and only implements the node kinds it cares about - the rest are empty and inline
+    //away. Concrete node classes are found from the type tags each node carries, so traversal makes no virtual calls
+    //A pass that treats every instruction (or operand) alike can implement visit(InstructionNode&) (or
+    //visit(OperandNode&)) instead, which every unimplemented concrete visit forwards to
+    template <typename Derived>
+    class Visitor {
+    public:
+        //Visit the root, then every instruction in parallel (operands before their instruction)
+        void traverse(RootNode& root);
+        //Visit one instruction - its operands first, then the instruction itself
+        void traverseInstruction(InstructionNode& node);
 
-    //AST Instruction node forward declarations
-    class MoveInstruction;
-    class LoadInstruction;
-    class StoreInstruction;
-    class CreateInstruction;
-    class CastInstruction;
-    class AddInstruction;
-    class SubInstruction;
-    class MultiplyInstruction;
-    class DivideInstruction;
-    class OrInstruction;
-    class AndInstruction;
-    class NotInstruction;
-    class ShiftInstruction;
-    class CompareInstruction;
-    class JumpInstruction;
-    class CallInstruction;
-    class PushInstruction;
-    class PopInstruction;
-    class ReturnInstruction;
-    class StopInstruction;
-    class InputInstruction;
-    class OutputInstruction;
-    class PrintInstruction;
-    class LabelInstruction;
-    class CommentInstruction;
+        //Default visit methods (forward to the general instruction/operand visit, which does nothing)
+        void visit(RootNode& node) {}
+        void visit(InstructionNode& node) {}
+        void visit(OperandNode& node) {}
 
-    //AST Operand node forward declarations
-    class RegisterOperand;
-    class InstructionAddressOperand;
-    class MemoryAddressOperand;
-    class IntegerOperand;
-    class FloatOperand;
-    class BooleanOperand;
-    class CharacterOperand;
-    class StringOperand;
-    class NewlineOperand;
-    class TypeConditionOperand;
-    class ShiftConditionOperand;
-    class JumpConditionOperand;
+        void visit(MoveInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(LoadInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(StoreInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(CreateInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(CastInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(AddInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(SubInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(MultiplyInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(DivideInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(OrInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(AndInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(NotInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(ShiftInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(CompareInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(JumpInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(CallInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(PushInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(PopInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(ReturnInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(StopInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(InputInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(OutputInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(PrintInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(LabelInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
+        void visit(CommentInstruction& node) { derived().visit(static_cast<InstructionNode&>(node)); }
 
-    class Visitor {
-    public:
-        virtual void visit(AST::RootNode &node) = 0;
+        void visit(RegisterOperand& node) { derived().visit(static_cast<OperandNode&>(node)); }
+        void visit(InstructionAddressOperand& node) { derived().visit(static_cast<OperandNode&>(node)); }
+        void visit(MemoryAddressOperand& node) { derived().visit(static_cast<OperandNode&>(node)); }
+        void visit(IntegerOperand& node) { derived().visit(static_cast<OperandNode&>(node)); }
+        void visit(FloatOperand& node) { derived().visit(static_cast<OperandNode&>(node)); }
+        void visit(BooleanOperand& node) { derived().visit(static_cast<OperandNode&>(node)); }
+        void visit(CharacterOperand& node) { derived().visit(static_cast<OperandNode&>(node)); }
+        void visit(StringOperand& node) { derived().visit(static_cast<OperandNode&>(node)); }
+        void visit(NewlineOperand& node) { derived().visit(static_cast<OperandNode&>(node)); }
+        void visit(TypeConditionOperand& node) { derived().visit(static_cast<OperandNode&>(node)); }
+        void visit(ShiftConditionOperand& node) { derived().visit(static_cast<OperandNode&>(node)); }
+        void visit(JumpConditionOperand& node) { derived().visit(static_cast<OperandNode&>(node)); }
 
-        virtual void visit(AST::MoveInstruction &node) = 0;
-        virtual void visit(AST::LoadInstruction &node) = 0;
-        virtual void visit(AST::StoreInstruction &node) = 0;
-        virtual void visit(AST::CreateInstruction &node) = 0;
-        virtual void visit(AST::CastInstruction &node) = 0;
-        virtual void visit(AST::AddInstruction &node) = 0;
-        virtual void visit(AST::SubInstruction &node) = 0;
-        virtual void visit(AST::MultiplyInstruction &node) = 0;
-        virtual void visit(AST::DivideInstruction &node) = 0;
-        virtual void visit(AST::OrInstruction &node) = 0;
-        virtual void visit(AST::AndInstruction &node) = 0;
-        virtual void visit(AST::NotInstruction &node) = 0;
-        virtual void visit(AST::ShiftInstruction &node) = 0;
-        virtual void visit(AST::CompareInstruction &node) = 0;
-        virtual void visit(AST::JumpInstruction &node) = 0;
-        virtual void visit(AST::CallInstruction &node) = 0;
-        virtual void visit(AST::PushInstruction &node) = 0;
-        virtual void visit(AST::PopInstruction &node) = 0;
-        virtual void visit(AST::ReturnInstruction &node) = 0;
-        virtual void visit(AST::StopInstruction &node) = 0;
-        virtual void visit(AST::InputInstruction &node) = 0;
-        virtual void visit(AST::OutputInstruction &node) = 0;
-        virtual void visit(AST::PrintInstruction &node) = 0;
-        virtual void visit(AST::LabelInstruction &node) = 0;
-        virtual void visit(AST::CommentInstruction &node) = 0;
+    protected:
+        Visitor() = default;
+        ~Visitor() = default;
 
-        virtual void visit(AST::RegisterOperand &node) = 0;
-        virtual void visit(AST::InstructionAddressOperand &node) = 0;
-        virtual void visit(AST::MemoryAddressOperand &node) = 0;
-        virtual void visit(AST::IntegerOperand &node) = 0;
-        virtual void visit(AST::FloatOperand &node) = 0;
-        virtual void visit(AST::BooleanOperand &node) = 0;
-        virtual void visit(AST::CharacterOperand &node) = 0;
-        virtual void visit(AST::StringOperand &node) = 0;
-        virtual void visit(AST::NewlineOperand &node) = 0;
-        virtual void visit(AST::TypeConditionOperand &node) = 0;
-        virtual void visit(AST::ShiftConditionOperand &node) = 0;
-        virtual void visit(AST::JumpConditionOperand &node) = 0;
+    private:
+        Derived& derived() { return static_cast<Derived&>(*this); }
+        void visitInstruction(InstructionNode& node);
+        void visitOperand(OperandNode& node);
     };
+
+    template <typename Derived>
+    void Visitor<Derived>::traverse(RootNode& root) {
+        //Visit for root node first (usually nothing)
+        derived().visit(root);
+        //Visit for all instruction children (multithreaded)
+        const std::vector<ASTNode*>& children = root.getChildren();
+        int numChildren = static_cast<int>(children.size());
+        #pragma omp parallel for schedule(auto) default(none) shared(children, numChildren)
+        for (int i=0; i<numChildren; i++) {
+            traverseInstruction(*static_cast<InstructionNode*>(children[i]));
+        }
+    }
+
+    template <typename Derived>
+    void Visitor<Derived>::traverseInstruction(InstructionNode& node) {
+        for (auto* child : node.getChildren()) {
+            visitOperand(*static_cast<OperandNode*>(child));
+        }
+        visitInstruction(node);
+    }
+
+    template <typename Derived>
+    void Visitor<Derived>::visitInstruction(InstructionNode& node) {
+        switch (node.getInstructionType()) {
+            case ASTConstants::MOVE:
+                derived().visit(static_cast<MoveInstruction&>(node));
+                break;
+            case ASTConstants::LOAD:
+                derived().visit(static_cast<LoadInstruction&>(node));
+                break;
+            case ASTConstants::STORE:
+                derived().visit(static_cast<StoreInstruction&>(node));
+                break;
+            case ASTConstants::CREATE:
+                derived().visit(static_cast<CreateInstruction&>(node));
+                break;
+            case ASTConstants::CAST:
+                derived().visit(static_cast<CastInstruction&>(node));
+                break;
+            case ASTConstants::ADD:
+                derived().visit(static_cast<AddInstruction&>(node));
+                break;
+            case ASTConstants::SUB:
+                derived().visit(static_cast<SubInstruction&>(node));
+                break;
+            case ASTConstants::MULTIPLY:
+                derived().visit(static_cast<MultiplyInstruction&>(node));
+                break;
+            case ASTConstants::DIVIDE:
+                derived().visit(static_cast<DivideInstruction&>(node));
+                break;
+            case ASTConstants::OR:
+                derived().visit(static_cast<OrInstruction&>(node));
+                break;
+            case ASTConstants::AND:
+                derived().visit(static_cast<AndInstruction&>(node));
+                break;
+            case ASTConstants::NOT:
+                derived().visit(static_cast<NotInstruction&>(node));
+                break;
+            case ASTConstants::SHIFT:
+                derived().visit(static_cast<ShiftInstruction&>(node));
+                break;
+            case ASTConstants::COMPARE:
+                derived().visit(static_cast<CompareInstruction&>(node));
+                break;
+            case ASTConstants::JUMP:
+                derived().visit(static_cast<JumpInstruction&>(node));
+                break;
+            case ASTConstants::CALL:
+                derived().visit(static_cast<CallInstruction&>(node));
+                break;
+            case ASTConstants::PUSH:
+                derived().visit(static_cast<PushInstruction&>(node));
+                break;
+            case ASTConstants::POP:
+                derived().visit(static_cast<PopInstruction&>(node));
+                break;
+            case ASTConstants::RETURN:
+                derived().visit(static_cast<ReturnInstruction&>(node));
+                break;
+            case ASTConstants::STOP:
+                derived().visit(static_cast<StopInstruction&>(node));
+                break;
+            case ASTConstants::INPUT:
+                derived().visit(static_cast<InputInstruction&>(node));
+                break;
+            case ASTConstants::OUTPUT:
+                derived().visit(static_cast<OutputInstruction&>(node));
+                break;
+            case ASTConstants::PRINT:
+                derived().visit(static_cast<PrintInstruction&>(node));
+                break;
+            case ASTConstants::LABEL:
+                derived().visit(static_cast<LabelInstruction&>(node));
+                break;
+            case ASTConstants::COMMENT:
+                derived().visit(static_cast<CommentInstruction&>(node));
+                break;
+            default:
+                break;
+        }
+    }
+
+    template <typename Derived>
+    void Visitor<Derived>::visitOperand(OperandNode& node) {
+        switch (node.getOperandType()) {
+            case ASTConstants::REGISTER:
+                derived().visit(static_cast<RegisterOperand&>(node));
+                break;
+            case ASTConstants::INSTRUCTIONADDRESS:
+                derived().visit(static_cast<InstructionAddressOperand&>(node));
+                break;
+            case ASTConstants::MEMORYADDRESS:
+                derived().visit(static_cast<MemoryAddressOperand&>(node));
+                break;
+            case ASTConstants::INTEGER:
+                derived().visit(static_cast<IntegerOperand&>(node));
+                break;
+            case ASTConstants::FLOAT:
+                derived().visit(static_cast<FloatOperand&>(node));
+                break;
+            case ASTConstants::BOOLEAN:
+                derived().visit(static_cast<BooleanOperand&>(node));
+                break;
+            case ASTConstants::CHARACTER:
+                derived().visit(static_cast<CharacterOperand&>(node));
+                break;
+            case ASTConstants::STRING:
+                derived().visit(static_cast<StringOperand&>(node));
+                break;
+            case ASTConstants::NEWLINE:
+                derived().visit(static_cast<NewlineOperand&>(node));
+                break;
+            case ASTConstants::TYPECONDITION:
+                derived().visit(static_cast<TypeConditionOperand&>(node));
+                break;
+            case ASTConstants::SHIFTCONDITION:
+                derived().visit(static_cast<ShiftConditionOperand&>(node));
+                break;
+            case ASTConstants::JUMPCONDITION:
+                derived().visit(static_cast<JumpConditionOperand&>(node));
+                break;
+            default:
+                break;
+        }
+    }
 }
 #endif
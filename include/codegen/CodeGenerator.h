@@ -11,55 +11,58 @@
 #include "ast/Visitor.h"
 #include "ast/AbstractSyntaxTree.h"
 
-class CodeGenerator : public AST::Visitor {
+class CodeGenerator : public AST::Visitor<CodeGenerator> {
     public:
         CodeGenerator();
         ~CodeGenerator() = default;
         //Remove copy and assignment operator
         CodeGenerator(const CodeGenerator&) = delete;
         CodeGenerator& operator=(const CodeGenerator&) = delete;
-        void visit(AST::RootNode& node) override;
+
+        // Visit methods (anything not listed here falls back to the empty defaults)
+        using AST::Visitor<CodeGenerator>::visit;
+        void visit(AST::RootNode& node);
 
 
         // Specific visit methods for each instruction
-        void visit(AST::MoveInstruction& node) override;
-        void visit(AST::LoadInstruction& node) override;
-        void visit(AST::StoreInstruction& node) override;
-        void visit(AST::CreateInstruction& node) override;
-        void visit(AST::CastInstruction& node) override;
-        void visit(AST::AddInstruction& node) override;
-        void visit(AST::SubInstruction& node) override;
-        void visit(AST::MultiplyInstruction& node) override;
-        void visit(AST::DivideInstruction& node) override;
-        void visit(AST::OrInstruction& node) override;
-        void visit(AST::AndInstruction& node) override;
-        void visit(AST::ShiftInstruction& node) override;
-        void visit(AST::CompareInstruction& node) override;
-        void visit(AST::JumpInstruction& node) override;
-        void visit(AST::CallInstruction& node) override;
-        void visit(AST::PushInstruction& node) override;
-        void visit(AST::PopInstruction& node) override;
-        void visit(AST::ReturnInstruction& node) override;
-        void visit(AST::StopInstruction& node) override;
-        void visit(AST::InputInstruction& node) override;
-        void visit(AST::OutputInstruction& node) override;
-        void visit(AST::PrintInstruction& node) override;
-        void visit(AST::LabelInstruction& node) override;
-        void visit(AST::CommentInstruction& node) override;
+        void visit(AST::MoveInstruction& node);
+        void visit(AST::LoadInstruction& node);
+        void visit(AST::StoreInstruction& node);
+        void visit(AST::CreateInstruction& node);
+        void visit(AST::CastInstruction& node);
+        void visit(AST::AddInstruction& node);
+        void visit(AST::SubInstruction& node);
+        void visit(AST::MultiplyInstruction& node);
+        void visit(AST::DivideInstruction& node);
+        void visit(AST::OrInstruction& node);
+        void visit(AST::AndInstruction& node);
+        void visit(AST::ShiftInstruction& node);
+        void visit(AST::CompareInstruction& node);
+        void visit(AST::JumpInstruction& node);
+        void visit(AST::CallInstruction& node);
+        void visit(AST::PushInstruction& node);
+        void visit(AST::PopInstruction& node);
+        void visit(AST::ReturnInstruction& node);
+        void visit(AST::StopInstruction& node);
+        void visit(AST::InputInstruction& node);
+        void visit(AST::OutputInstruction& node);
+        void visit(AST::PrintInstruction& node);
+        void visit(AST::LabelInstruction& node);
+        void visit(AST::CommentInstruction& node);
 
         // Specific visit methods for each operand
-        void visit(AST::RegisterOperand& node) override;
-        void visit(AST::InstructionAddressOperand& node) override;
-        void visit(AST::MemoryAddressOperand& node) override;
-        void visit(AST::IntegerOperand& node) override;
-        void visit(AST::FloatOperand& node) override;
-        void visit(AST::BooleanOperand& node) override;
-        void visit(AST::CharacterOperand& node) override;
-        void visit(AST::StringOperand& node) override;
-        void visit(AST::NewlineOperand& node) override;
-        void visit(AST::TypeConditionOperand& node) override;
-        void visit(AST::ShiftConditionOperand& node) override;
-        void visit(AST::JumpConditionOperand& node) override;
+        void visit(AST::RegisterOperand& node);
+        void visit(AST::InstructionAddressOperand& node);
+        void visit(AST::MemoryAddressOperand& node);
+        void visit(AST::IntegerOperand& node);
+        void visit(AST::FloatOperand& node);
+        void visit(AST::BooleanOperand& node);
+        void visit(AST::CharacterOperand& node);
+        void visit(AST::StringOperand& node);
+        void visit(AST::NewlineOperand& node);
+        void visit(AST::TypeConditionOperand& node);
+        void visit(AST::ShiftConditionOperand& node);
+        void visit(AST::JumpConditionOperand& node);
 
         void printIR();
 
@@ -3,8 +3,13 @@
 
 #include "lexer/Lexer.h"
 #include "ast/AbstractSyntaxTree.h"
+#include "ast/Program.h"
+#include "symbolres/SymbolResolver.h"
+#include "diagnostics/DiagnosticEngine.h"
 
 #include <string>
+#include <string_view>
+#include <cstddef>
 #include <utility>
 #include <vector>
 #include <unordered_map>
@@ -12,7 +17,6 @@
 #include <utility>
 
 class Parser;
-class SymbolResolver;
 class ASTBuilder;
 class SemanticAnalyzer;
 class ScopeChecker;
@@ -21,7 +25,7 @@ class CodeGenerator;
 class Compiler {
     public:
         //Constructors and Destructors
-        Compiler(std::string& pathname, bool cmdSilent, bool cmdTimings, bool cmdTree, bool cmdIr);
+        Compiler(std::string& pathname, bool cmdSilent, bool cmdTimings, bool cmdTree, bool cmdIr, bool cmdTokens, bool cmdParseTree, bool cmdSoa, LexerConstants::ClassifierMode lexerMode, std::size_t maxErrors = 0);
         ~Compiler();
 
         Compiler(const Compiler&) = delete;
@@ -30,11 +34,11 @@ class Compiler {
         //Accessors
         //Get number of lines
         [[nodiscard]] int getNumLines() const {
-            return int(m_codeLines.size());
+            return int(m_source.numLines());
         }
-        //Get current status
+        //Get current status - diagnostics are only formatted here
         [[nodiscard]] std::string getStatus() const {
-            return m_statusMessage;
+            return m_statusMessage + m_diagnostics.format(m_source);
         }
 
         //Mutators
@@ -55,29 +59,35 @@ class Compiler {
     private:
         //Private variables
         //Data structures
-        //Vector containing code lines
-        std::vector<std::string> m_codeLines;
-        //Vector containing code tokens and tags
-        std::vector<std::vector<std::pair<std::string, LexerConstants::TokenType>>> m_codeTokens;
-        //Parse tree for the code
+        //Memory mapped source file and its lines, shared by every pass (tokens and tree nodes are views into it)
+        SourceManager m_source;
+        //Flat stream of code tokens and tags
+        TokenStream m_codeTokens;
+        //Parse tree for the code (only built on the two-tree path)
         PT::ParseTree* m_parseTree;
-        //Hash table for symbol resolution, mapping labels to instruction addresses
-        std::unordered_map<std::string, std::pair<std::string, int>> m_symbolTable;
+        //Dense program for the analysis passes (only built on the structure-of-arrays path)
+        AST::Program* m_program;
+        //Label declarations and operands the parser recorded, for symbol resolution to fix up
+        LabelTable m_labelTable;
+        //Symbol table for symbol resolution, mapping label IDs to their declarations
+        SymbolTable m_symbolTable;
 
         //Variables and data structures
         //Pathname
         std::string m_pathname;
         //String containing current status
         std::string m_statusMessage;
+        //Errors found by every stage, in the order they are reported
+        DiagnosticEngine m_diagnostics;
         //Lexer
         Lexer* m_lexer;
         //Parser (PT nested inside parser)
         Parser* m_parser;
         //Symbol Resolver
         SymbolResolver* m_symbolResolver;
-        //AST (used directly by the compiler at multiple stages)
+        //AST (used directly by the compiler at multiple stages - null on the dense path)
         AST::AbstractSyntaxTree* m_AST;
-        //AST Builder
+        //AST Builder (null on the dense path)
         ASTBuilder* m_ASTBuilder;
         //Pointer to semantic analyzer
         SemanticAnalyzer* m_semanticAnalyzer;
@@ -91,6 +101,9 @@ class Compiler {
         bool cmd_timings;
         bool cmd_tree;
         bool cmd_ir;
+        bool cmd_tokens;
+        bool cmd_parseTree;
+        bool cmd_soa;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,131 @@
+#ifndef DIAGNOSTICENGINE_H
+#define DIAGNOSTICENGINE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <climits>
+#include <atomic>
+
+#include "lexer/SourceManager.h"
+#include "lang/OperandValue.h"
+
+namespace DiagnosticConstants {
+    //What a diagnostic reports - each code has one message template
+    enum Code : uint8_t {
+        //Syntax errors (parser)
+        UNKNOWN_INSTRUCTION, MISSING_PARSING_METHOD, EXCESS_TOKENS, MISSING_CONJUNCTION, UNKNOWN_CONJUNCTION,
+        MISSING_CONDITION, UNKNOWN_CONDITION, MISSING_OPERAND, UNKNOWN_OPERAND, MISSING_DESCRIPTOR, UNKNOWN_DESCRIPTOR,
+        //Label errors (symbol resolver)
+        DUPLICATE_LABEL, UNDEFINED_LABEL,
+        //Scope errors (scope checker)
+        REGISTER_SCOPE, MEMORY_SCOPE, INSTRUCTION_SCOPE, INSTRUCTION_LIMIT,
+        //Semantic errors (semantic analyzer) - consecutive ones on a line share one heading
+        UNRECOGNIZED_OPERAND, EXTRA_OPERAND
+    };
+}
+
+//Compact diagnostic record. Nothing is formatted when a diagnostic is raised - texts are views into the source (or
+//static tables), and the message is only built when the report is written
+struct Diagnostic {
+    DiagnosticConstants::Code code;
+    //Line index the diagnostic is on
+    int line;
+    //Token or operand the message names
+    std::string_view token;
+    //Second text - the token before it, the keyword expected or the operand types expected
+    std::string_view detail;
+    //Line index the label was first declared on (duplicate labels)
+    int declaredLine = 0;
+    //Set for an operand that is a resolved label - its text is i[labelAddress] rather than the token
+    uint32_t labelAddress = 0;
+
+    //Diagnostic naming an operand, given its source text and value
+    static Diagnostic operand(DiagnosticConstants::Code code, int line, std::string_view text, const OperandValue& value) {
+        return {code, line, text, {}, 0, value.label ? value.payload.address : 0};
+    }
+};
+
+//Diagnostics raised by one thread, in line order
+using DiagnosticBuffer = std::vector<Diagnostic>;
+
+//Line past which a parallel loop can stop raising diagnostics. Threads raise in line order, each into its own buffer -
+//once one buffer holds the most diagnostics the stage may report, the lowest-numbered ones are all at or before its
+//last line, so every thread can skip the lines after it. Lines up to the cutoff are always checked in full, so the
+//diagnostics kept don't depend on thread timing
+class DiagnosticCutoff {
+    public:
+        //No limit by default
+        DiagnosticCutoff() = default;
+        ~DiagnosticCutoff() = default;
+        //Delete copy and assignment
+        DiagnosticCutoff(const DiagnosticCutoff&) = delete;
+        DiagnosticCutoff& operator=(const DiagnosticCutoff&) = delete;
+
+        //Start over for a stage that may report up to maxErrors diagnostics (0 for no limit)
+        void reset(std::size_t maxErrors) {
+            m_maxErrors = maxErrors;
+            m_line.store(INT_MAX, std::memory_order_relaxed);
+        }
+        //Whether a line is past the cutoff and can be skipped
+        [[nodiscard]] bool reached(int line) const {
+            return line > m_line.load(std::memory_order_relaxed);
+        }
+        //Called after a thread raised a diagnostic - numRaised it has raised so far, the last on lastLine
+        void update(std::size_t numRaised, int lastLine) {
+            if (m_maxErrors == 0 || numRaised < m_maxErrors) {
+                return;
+            }
+            int line = m_line.load(std::memory_order_relaxed);
+            while (lastLine < line && !m_line.compare_exchange_weak(line, lastLine, std::memory_order_relaxed)) {}
+        }
+        void update(const DiagnosticBuffer& buffer) {
+            update(buffer.size(), buffer.back().line);
+        }
+
+    private:
+        std::size_t m_maxErrors = 0;
+        std::atomic<int> m_line{INT_MAX};
+};
+
+//Collects the diagnostics of a compile as records and writes them out as one report. Threads raise diagnostics into
+//their own buffers, which are merged into the engine serially, so raising never locks
+class DiagnosticEngine {
+    public:
+        DiagnosticEngine() = default;
+        ~DiagnosticEngine() = default;
+        //Delete copy and assignment
+        DiagnosticEngine(const DiagnosticEngine&) = delete;
+        DiagnosticEngine& operator=(const DiagnosticEngine&) = delete;
+
+        //Add one stage's diagnostics - buffers each in line order, k-way merged by line. Diagnostics on the same line
+        //keep the order of their buffers, and each stage is written after the ones added before it. Only the first
+        //diagnostics up to the limit are kept
+        void report(std::vector<DiagnosticBuffer>& buffers);
+
+        //Accessors
+        [[nodiscard]] bool empty() const { return m_diagnostics.empty(); }
+        [[nodiscard]] std::size_t size() const { return m_diagnostics.size(); }
+        [[nodiscard]] std::size_t getMaxErrors() const { return m_maxErrors; }
+        //Most diagnostics a stage may still report (0 for no limit)
+        [[nodiscard]] std::size_t remaining() const {
+            return m_maxErrors == 0 ? 0 : m_maxErrors - m_diagnostics.size();
+        }
+        //Whether the limit has been reached, so no further stage should run
+        [[nodiscard]] bool full() const { return m_maxErrors != 0 && m_diagnostics.size() >= m_maxErrors; }
+
+        //Mutators
+        //Keep at most maxErrors diagnostics (0 for no limit)
+        void setMaxErrors(std::size_t maxErrors) { m_maxErrors = maxErrors; }
+
+        //Format every diagnostic, in report order, into one buffer
+        [[nodiscard]] std::string format(const SourceManager& source) const;
+
+    private:
+        std::vector<Diagnostic> m_diagnostics;
+        std::size_t m_maxErrors = 0;
+};
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef INSTRUCTIONSET_H
+#define INSTRUCTIONSET_H
+
+#include "ast/ASTConstants.h"
+
+#include <array>
+#include <string_view>
+#include <initializer_list>
+#include <cstddef>
+
+//Compile-time specification of the StartASM instruction set - one entry per instruction, indexed by opcode, holding
+//everything any stage needs to know about it. The keyword table (lang/Keywords.h), the parser's templates, the AST
+//instruction nodes and builder, and the semantic analyzer's operand signatures are all derived from it
+namespace InstructionSet {
+    //Most operands an instruction takes
+    inline constexpr int MAX_OPERANDS = 3;
+    //Most operand types any operand slot accepts
+    inline constexpr int MAX_SLOT_TYPES = 6;
+
+    //Level 2 checks a parsing template is made of
+    enum GrammarCheck {IMPLICIT_CONJUNCTION, IMPLICIT_CONDITION, EXPLICIT_CONJUNCTION, EXPLICIT_CONDITION};
+
+    //One step of a parsing template - the check, its keyword and where it is expected in the token sequence. Each
+    //step introduces one operand
+    struct GrammarElement {
+        GrammarCheck check;
+        std::string_view keyword;
+        int index;
+    };
+
+    //Parsing template of an instruction, along with the number of tokens a valid line has
+    struct Grammar {
+        const GrammarElement* elements;
+        std::size_t numElements;
+        std::size_t numTokens;
+    };
+
+    //Valid operand types of one slot, in the order error messages list them
+    struct SlotSignature {
+        ASTConstants::OperandType types[MAX_SLOT_TYPES]{};
+        int numTypes = 0;
+    };
+
+    struct Instruction {
+        //Keyword that introduces the instruction
+        std::string_view name;
+        ASTConstants::InstructionType type;
+        //Parsing template
+        Grammar grammar;
+        //Valid operand types at each position (EMPTY where no operand is expected)
+        SlotSignature operands[MAX_OPERANDS];
+    };
+
+    //Parsing templates
+    inline constexpr GrammarElement MOVE_GRAMMAR[] = {{IMPLICIT_CONJUNCTION, "from", 0}, {EXPLICIT_CONJUNCTION, "to", 2}};
+    inline constexpr GrammarElement CREATE_GRAMMAR[] = {{IMPLICIT_CONDITION, "type", 0}, {IMPLICIT_CONJUNCTION, "from", 1}, {EXPLICIT_CONJUNCTION, "to", 3}};
+    inline constexpr GrammarElement CAST_GRAMMAR[] = {{IMPLICIT_CONDITION, "type", 0}, {IMPLICIT_CONJUNCTION, "self", 1}};
+    inline constexpr GrammarElement ARITHMETIC_GRAMMAR[] = {{IMPLICIT_CONJUNCTION, "from", 0}, {EXPLICIT_CONJUNCTION, "with", 2}, {EXPLICIT_CONJUNCTION, "to", 4}};
+    inline constexpr GrammarElement LOGIC_GRAMMAR[] = {{IMPLICIT_CONJUNCTION, "self", 0}, {EXPLICIT_CONJUNCTION, "with", 2}};
+    inline constexpr GrammarElement NOT_GRAMMAR[] = {{IMPLICIT_CONJUNCTION, "self", 0}};
+    inline constexpr GrammarElement SHIFT_GRAMMAR[] = {{IMPLICIT_CONDITION, "direction", 0}, {IMPLICIT_CONJUNCTION, "self", 1}, {EXPLICIT_CONJUNCTION, "by", 3}};
+    inline constexpr GrammarElement JUMP_GRAMMAR[] = {{EXPLICIT_CONDITION, "if", 1}, {EXPLICIT_CONJUNCTION, "to", 3}};
+    inline constexpr GrammarElement TO_GRAMMAR[] = {{EXPLICIT_CONJUNCTION, "to", 1}};
+    inline constexpr GrammarElement FROM_GRAMMAR[] = {{IMPLICIT_CONJUNCTION, "from", 0}};
+    inline constexpr GrammarElement INPUT_GRAMMAR[] = {{IMPLICIT_CONDITION, "type", 0}, {EXPLICIT_CONJUNCTION, "to", 2}};
+    inline constexpr GrammarElement STATIC_GRAMMAR[] = {{IMPLICIT_CONJUNCTION, "static", 0}};
+
+    template <std::size_t N>
+    constexpr Grammar grammar(const GrammarElement (&elements)[N], std::size_t numTokens) {
+        return Grammar{elements, N, numTokens};
+    }
+    inline constexpr Grammar NO_OPERANDS = {nullptr, 0, 1};
+    inline constexpr Grammar NO_GRAMMAR = {nullptr, 0, 0};
+
+    constexpr SlotSignature slot(std::initializer_list<ASTConstants::OperandType> types) {
+        SlotSignature signature;
+        for (ASTConstants::OperandType type : types) {
+            signature.types[signature.numTypes++] = type;
+        }
+        return signature;
+    }
+
+    //Every instruction, in opcode order. The NONE entry stands for a blank line - no keyword and no operands
+    inline constexpr Instruction INSTRUCTIONS[] = {
+        {"move", ASTConstants::MOVE, grammar(MOVE_GRAMMAR, 4), {slot({ASTConstants::REGISTER}), slot({ASTConstants::REGISTER}), slot({ASTConstants::EMPTY})}},
+        {"load", ASTConstants::LOAD, grammar(MOVE_GRAMMAR, 4), {slot({ASTConstants::REGISTER, ASTConstants::MEMORYADDRESS}), slot({ASTConstants::REGISTER}), slot({ASTConstants::EMPTY})}},
+        {"store", ASTConstants::STORE, grammar(MOVE_GRAMMAR, 4), {slot({ASTConstants::REGISTER}), slot({ASTConstants::REGISTER, ASTConstants::MEMORYADDRESS}), slot({ASTConstants::EMPTY})}},
+        {"create", ASTConstants::CREATE, grammar(CREATE_GRAMMAR, 5), {slot({ASTConstants::TYPECONDITION}), slot({ASTConstants::INSTRUCTIONADDRESS, ASTConstants::MEMORYADDRESS, ASTConstants::FLOAT, ASTConstants::BOOLEAN, ASTConstants::CHARACTER, ASTConstants::INTEGER}), slot({ASTConstants::REGISTER})}},
+        {"cast", ASTConstants::CAST, grammar(CAST_GRAMMAR, 3), {slot({ASTConstants::TYPECONDITION}), slot({ASTConstants::REGISTER}), slot({ASTConstants::EMPTY})}},
+        {"add", ASTConstants::ADD, grammar(ARITHMETIC_GRAMMAR, 6), {slot({ASTConstants::REGISTER}), slot({ASTConstants::REGISTER}), slot({ASTConstants::REGISTER})}},
+        {"sub", ASTConstants::SUB, grammar(ARITHMETIC_GRAMMAR, 6), {slot({ASTConstants::REGISTER}), slot({ASTConstants::REGISTER}), slot({ASTConstants::REGISTER})}},
+        {"multiply", ASTConstants::MULTIPLY, grammar(ARITHMETIC_GRAMMAR, 6), {slot({ASTConstants::REGISTER}), slot({ASTConstants::REGISTER}), slot({ASTConstants::REGISTER})}},
+        {"divide", ASTConstants::DIVIDE, grammar(ARITHMETIC_GRAMMAR, 6), {slot({ASTConstants::REGISTER}), slot({ASTConstants::REGISTER}), slot({ASTConstants::REGISTER})}},
+        {"or", ASTConstants::OR, grammar(LOGIC_GRAMMAR, 4), {slot({ASTConstants::REGISTER}), slot({ASTConstants::REGISTER}), slot({ASTConstants::EMPTY})}},
+        {"and", ASTConstants::AND, grammar(LOGIC_GRAMMAR, 4), {slot({ASTConstants::REGISTER}), slot({ASTConstants::REGISTER}), slot({ASTConstants::EMPTY})}},
+        {"not", ASTConstants::NOT, grammar(NOT_GRAMMAR, 2), {slot({ASTConstants::REGISTER}), slot({ASTConstants::EMPTY}), slot({ASTConstants::EMPTY})}},
+        {"shift", ASTConstants::SHIFT, grammar(SHIFT_GRAMMAR, 6), {slot({ASTConstants::SHIFTCONDITION}), slot({ASTConstants::REGISTER}), slot({ASTConstants::REGISTER})}},
+        {"compare", ASTConstants::COMPARE, grammar(LOGIC_GRAMMAR, 4), {slot({ASTConstants::REGISTER}), slot({ASTConstants::REGISTER}), slot({ASTConstants::EMPTY})}},
+        {"jump", ASTConstants::JUMP, grammar(JUMP_GRAMMAR, 5), {slot({ASTConstants::JUMPCONDITION}), slot({ASTConstants::REGISTER, ASTConstants::INSTRUCTIONADDRESS}), slot({ASTConstants::EMPTY})}},
+        {"call", ASTConstants::CALL, grammar(TO_GRAMMAR, 3), {slot({ASTConstants::REGISTER, ASTConstants::INSTRUCTIONADDRESS}), slot({ASTConstants::EMPTY}), slot({ASTConstants::EMPTY})}},
+        {"push", ASTConstants::PUSH, grammar(FROM_GRAMMAR, 2), {slot({ASTConstants::REGISTER}), slot({ASTConstants::EMPTY}), slot({ASTConstants::EMPTY})}},
+        {"pop", ASTConstants::POP, grammar(TO_GRAMMAR, 3), {slot({ASTConstants::REGISTER}), slot({ASTConstants::EMPTY}), slot({ASTConstants::EMPTY})}},
+        {"return", ASTConstants::RETURN, NO_OPERANDS, {slot({ASTConstants::EMPTY}), slot({ASTConstants::EMPTY}), slot({ASTConstants::EMPTY})}},
+        {"stop", ASTConstants::STOP, NO_OPERANDS, {slot({ASTConstants::EMPTY}), slot({ASTConstants::EMPTY}), slot({ASTConstants::EMPTY})}},
+        {"input", ASTConstants::INPUT, grammar(INPUT_GRAMMAR, 4), {slot({ASTConstants::TYPECONDITION}), slot({ASTConstants::REGISTER}), slot({ASTConstants::EMPTY})}},
+        {"output", ASTConstants::OUTPUT, grammar(FROM_GRAMMAR, 2), {slot({ASTConstants::REGISTER}), slot({ASTConstants::EMPTY}), slot({ASTConstants::EMPTY})}},
+        {"print", ASTConstants::PRINT, grammar(FROM_GRAMMAR, 2), {slot({ASTConstants::NEWLINE, ASTConstants::STRING}), slot({ASTConstants::EMPTY}), slot({ASTConstants::EMPTY})}},
+        {"label", ASTConstants::LABEL, grammar(STATIC_GRAMMAR, 2), {slot({ASTConstants::INSTRUCTIONADDRESS}), slot({ASTConstants::EMPTY}), slot({ASTConstants::EMPTY})}},
+        {"comment", ASTConstants::COMMENT, grammar(STATIC_GRAMMAR, 2), {slot({ASTConstants::STRING}), slot({ASTConstants::EMPTY}), slot({ASTConstants::EMPTY})}},
+        {"", ASTConstants::NONE, NO_GRAMMAR, {slot({ASTConstants::EMPTY}), slot({ASTConstants::EMPTY}), slot({ASTConstants::EMPTY})}},
+    };
+    inline constexpr std::size_t NUM_INSTRUCTIONS = ASTConstants::NONE;
+
+    //Number of operands an instruction takes - the slots that expect one
+    constexpr int operandCount(const Instruction& instruction) {
+        int count = 0;
+        for (const SlotSignature& operand : instruction.operands) {
+            count += !(operand.numTypes == 1 && operand.types[0] == ASTConstants::EMPTY);
+        }
+        return count;
+    }
+    constexpr ASTConstants::NumOperands getNumOperands(ASTConstants::InstructionType type) {
+        return static_cast<ASTConstants::NumOperands>(operandCount(INSTRUCTIONS[type]));
+    }
+
+    //Check the table is in opcode order, and that every parsing template matches its operand slots
+    constexpr bool isConsistent() {
+        if (sizeof(INSTRUCTIONS) / sizeof(INSTRUCTIONS[0]) != NUM_INSTRUCTIONS + 1) {
+            return false;
+        }
+        for (std::size_t i = 0; i <= NUM_INSTRUCTIONS; i++) {
+            const Instruction& instruction = INSTRUCTIONS[i];
+            if (instruction.type != static_cast<ASTConstants::InstructionType>(i) || static_cast<int>(instruction.grammar.numElements) != operandCount(instruction)) {
+                return false;
+            }
+            //Operands fill the slots from the front
+            for (int j = 0; j < MAX_OPERANDS; j++) {
+                if (j >= operandCount(instruction) && !(instruction.operands[j].numTypes == 1 && instruction.operands[j].types[0] == ASTConstants::EMPTY)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    static_assert(isConsistent(), "Instruction table must be in opcode order, with a parsing template step per operand");
+}
+
+#endif
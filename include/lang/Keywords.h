@@ -0,0 +1,171 @@
+#ifndef KEYWORDS_H
+#define KEYWORDS_H
+
+#include "lexer/LexerConstants.h"
+#include "ast/ASTConstants.h"
+#include "lang/InstructionSet.h"
+
+#include <array>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+//Compile-time perfect hash table of every StartASM keyword. A lookup hashes the token once, probes a single slot
+//and confirms with one string comparison - no heap strings and no runtime table construction
+namespace Keywords {
+    //Parsing templates come from the instruction set
+    using InstructionSet::GrammarCheck;
+    using InstructionSet::GrammarElement;
+    using InstructionSet::Grammar;
+    using InstructionSet::IMPLICIT_CONJUNCTION;
+    using InstructionSet::IMPLICIT_CONDITION;
+    using InstructionSet::EXPLICIT_CONJUNCTION;
+    using InstructionSet::EXPLICIT_CONDITION;
+
+    struct Keyword {
+        std::string_view name;
+        LexerConstants::TokenType tokenType;
+        //Instruction the keyword introduces (NONE for conjunctions and conditions)
+        ASTConstants::InstructionType instructionType;
+        //Parsing template (empty for conjunctions and conditions)
+        Grammar grammar;
+    };
+
+    //Keywords that don't introduce an instruction
+    inline constexpr Keyword OPERAND_KEYWORDS[] = {
+        //Conjunctions
+        {"from", LexerConstants::CONJUNCTION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"with", LexerConstants::CONJUNCTION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"self", LexerConstants::CONJUNCTION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"to", LexerConstants::CONJUNCTION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"by", LexerConstants::CONJUNCTION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"if", LexerConstants::CONJUNCTION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        //Conditions
+        {"left", LexerConstants::SHIFTCONDITION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"right", LexerConstants::SHIFTCONDITION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"greater", LexerConstants::JUMPCONDITION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"less", LexerConstants::JUMPCONDITION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"equal", LexerConstants::JUMPCONDITION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"unequal", LexerConstants::JUMPCONDITION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"zero", LexerConstants::JUMPCONDITION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"nonzero", LexerConstants::JUMPCONDITION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"unconditional", LexerConstants::JUMPCONDITION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"integer", LexerConstants::TYPECONDITION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"float", LexerConstants::TYPECONDITION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"boolean", LexerConstants::TYPECONDITION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"character", LexerConstants::TYPECONDITION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"memory", LexerConstants::TYPECONDITION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+        {"instruction", LexerConstants::TYPECONDITION, ASTConstants::NONE, InstructionSet::NO_GRAMMAR},
+    };
+    inline constexpr std::size_t NUM_OPERAND_KEYWORDS = sizeof(OPERAND_KEYWORDS) / sizeof(OPERAND_KEYWORDS[0]);
+
+    //Every keyword - the instruction keywords (in opcode order) taken from the instruction set, then the rest
+    constexpr std::array<Keyword, InstructionSet::NUM_INSTRUCTIONS + NUM_OPERAND_KEYWORDS> buildKeywords() {
+        std::array<Keyword, InstructionSet::NUM_INSTRUCTIONS + NUM_OPERAND_KEYWORDS> keywords{};
+        for (std::size_t i = 0; i < InstructionSet::NUM_INSTRUCTIONS; i++) {
+            const InstructionSet::Instruction& instruction = InstructionSet::INSTRUCTIONS[i];
+            keywords[i] = {instruction.name, LexerConstants::INSTRUCTION, instruction.type, instruction.grammar};
+        }
+        for (std::size_t i = 0; i < NUM_OPERAND_KEYWORDS; i++) {
+            keywords[InstructionSet::NUM_INSTRUCTIONS + i] = OPERAND_KEYWORDS[i];
+        }
+        return keywords;
+    }
+
+    inline constexpr std::array<Keyword, InstructionSet::NUM_INSTRUCTIONS + NUM_OPERAND_KEYWORDS> KEYWORDS = buildKeywords();
+
+    inline constexpr std::size_t NUM_KEYWORDS = KEYWORDS.size();
+    //One slot per value of the top byte of the hash
+    inline constexpr std::size_t TABLE_SIZE = 256;
+    inline constexpr uint8_t EMPTY_SLOT = 0xFF;
+    inline constexpr uint32_t NO_SEED = UINT32_MAX;
+    static_assert(NUM_KEYWORDS < EMPTY_SLOT, "Keyword indices must fit in a slot byte");
+
+    //Seeded FNV-1a
+    constexpr uint32_t hash(std::string_view key, uint32_t seed) {
+        uint32_t h = 2166136261u ^ seed;
+        for (char c : key) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    //Slot of a key. Taken from the high bits, since FNV-1a's low bits only depend on the low bits of the seed
+    constexpr std::size_t slot(std::string_view key, uint32_t seed) {
+        return hash(key, seed) >> 24;
+    }
+
+    constexpr std::size_t maxKeywordLength() {
+        std::size_t length = 0;
+        for (const Keyword& keyword : KEYWORDS) {
+            length = keyword.name.size() > length ? keyword.name.size() : length;
+        }
+        return length;
+    }
+
+    //Check whether a seed maps every keyword to its own slot
+    constexpr bool isPerfectSeed(uint32_t seed) {
+        bool used[TABLE_SIZE] = {};
+        for (const Keyword& keyword : KEYWORDS) {
+            std::size_t index = slot(keyword.name, seed);
+            if (used[index]) {
+                return false;
+            }
+            used[index] = true;
+        }
+        return true;
+    }
+
+    //Search for the first collision-free seed
+    constexpr uint32_t findSeed() {
+        for (uint32_t seed = 0; seed < 100000; seed++) {
+            if (isPerfectSeed(seed)) {
+                return seed;
+            }
+        }
+        return NO_SEED;
+    }
+
+    inline constexpr uint32_t SEED = findSeed();
+    static_assert(SEED != NO_SEED, "No perfect hash seed found for the keyword table");
+    inline constexpr std::size_t MAX_KEYWORD_LENGTH = maxKeywordLength();
+
+    constexpr std::array<uint8_t, TABLE_SIZE> buildSlots() {
+        std::array<uint8_t, TABLE_SIZE> slots{};
+        for (std::size_t i = 0; i < TABLE_SIZE; i++) {
+            slots[i] = EMPTY_SLOT;
+        }
+        for (std::size_t i = 0; i < NUM_KEYWORDS; i++) {
+            slots[slot(KEYWORDS[i].name, SEED)] = static_cast<uint8_t>(i);
+        }
+        return slots;
+    }
+
+    inline constexpr std::array<uint8_t, TABLE_SIZE> SLOTS = buildSlots();
+
+    //Find a keyword, or nullptr if the token is not one
+    constexpr const Keyword* lookup(std::string_view token) {
+        if (token.empty() || token.size() > MAX_KEYWORD_LENGTH) {
+            return nullptr;
+        }
+        uint8_t index = SLOTS[slot(token, SEED)];
+        if (index == EMPTY_SLOT || KEYWORDS[index].name != token) {
+            return nullptr;
+        }
+        return &KEYWORDS[index];
+    }
+
+    //Instruction introduced by a keyword (NONE if the token is not an instruction keyword)
+    constexpr ASTConstants::InstructionType getInstructionType(std::string_view token) {
+        const Keyword* keyword = lookup(token);
+        return keyword != nullptr ? keyword->instructionType : ASTConstants::NONE;
+    }
+
+    //Keyword that introduces an instruction (empty for NONE)
+    constexpr std::string_view getInstructionName(ASTConstants::InstructionType type) {
+        return InstructionSet::INSTRUCTIONS[type].name;
+    }
+}
+
+#endif
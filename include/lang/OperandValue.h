@@ -0,0 +1,26 @@
+#ifndef OPERANDVALUE_H
+#define OPERANDVALUE_H
+
+#include <cstdint>
+
+//Numeric payload of an operand. Decoded once by the lexer and carried through the PT and AST, so no later stage
+//has to parse operand text again
+union OperandPayload {
+    //Register index, memory address or instruction address
+    uint32_t address;
+    int32_t integer;
+    float real;
+    //Interned label ID (label tokens, until the label is resolved to an instruction address)
+    uint32_t symbol;
+};
+
+struct OperandValue {
+    OperandPayload payload{};
+    //Set if the literal does not fit its payload (the payload is then meaningless, the text is still kept)
+    bool overflow = false;
+    //Set once a label has been resolved - the payload is then the target instruction address, and the i[n] text is
+    //only formatted when a diagnostic or tree dump needs it
+    bool label = false;
+};
+
+#endif
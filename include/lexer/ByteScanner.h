@@ -0,0 +1,40 @@
+#ifndef BYTESCANNER_H
+#define BYTESCANNER_H
+
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace ByteScannerConstants {
+    enum ScannerLevel {SCALAR, SSE42, AVX2};
+}
+
+//Bulk byte scanner for line and token boundaries. Bytes are classified 64 at a time into bitmasks using the
+//widest instruction set the CPU supports (detected once at runtime), and boundaries are read off the masks
+class ByteScanner {
+    public:
+        //Delete construction - scanner is stateless
+        ByteScanner() = delete;
+
+        //Instruction set selected for this CPU
+        static ByteScannerConstants::ScannerLevel getLevel();
+        static const char* getLevelName();
+
+        //Append a view for every line in the buffer (excluding newlines, no trailing empty line)
+        static void indexLines(const char* data, std::size_t size, std::vector<std::string_view>& lines);
+        //Replace the contents of tokens with views of every whitespace separated token in the line
+        static void splitTokens(std::string_view line, std::vector<std::string_view>& tokens);
+
+    private:
+        //Bitmask builders over 64 readable bytes (bit i set if byte i matches)
+        using MaskFunction = uint64_t (*)(const char*);
+        struct MaskFunctions {
+            ByteScannerConstants::ScannerLevel level;
+            MaskFunction newlineMask;
+            MaskFunction whitespaceMask;
+        };
+        static const MaskFunctions& getMaskFunctions();
+};
+
+#endif
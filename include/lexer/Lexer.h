@@ -1,38 +1,51 @@
 #ifndef LEXER_H
 #define LEXER_H
 
+#include "lexer/LexerConstants.h"
+#include "lexer/SourceManager.h"
+#include "lexer/TokenStream.h"
+
 #include <string>
+#include <string_view>
 #include <vector>
-#include <unordered_map>
 #include <utility>
 #include <regex>
 
-namespace LexerConstants {
-    enum TokenType {INSTRUCTION, CONJUNCTION, JUMPCONDITION, TYPECONDITION, SHIFTCONDITION, REGISTER, INSTRUCTIONADDRESS, MEMORYADDRESS, INTEGER, FLOAT, BOOLEAN, CHARACTER, LABEL, STRING, BLANK, NEWLINE, UNKNOWN};
-}
-
 class Lexer {
     public:
-        Lexer();
+        explicit Lexer(LexerConstants::ClassifierMode classifierMode = LexerConstants::ClassifierMode::DFA);
         ~Lexer() = default;
         //Delete copy and assignment
         Lexer(const Lexer&) = delete;
         Lexer& operator=(const Lexer&) = delete;
 
-        //Lexer method
-        bool lexFile(const std::string&, std::vector<std::string>&, std::vector<std::vector<std::pair<std::string, LexerConstants::TokenType>>>&);
+        //Lexer method - maps the file into the source manager, indexing its lines, and tokenizes it
+        bool lexFile(const std::string&, SourceManager&, TokenStream&);
+
+        //Operand classifiers (regex reference set and table-driven DFA)
+        LexerConstants::TokenType classifyOperandRegex(std::string_view token) const;
+        static LexerConstants::TokenType classifyOperandDFA(std::string_view token);
+        //Numeric payload of a classified operand (zero for non-numeric tokens)
+        static OperandValue decodeOperand(std::string_view token, LexerConstants::TokenType type);
+
+        //Token printing (debug)
+        static std::string tokenTypeToString(LexerConstants::TokenType type);
+        static void printTokens(const TokenStream& tokenizedCode);
 
     private:
-        //File reader function
-        bool readFile(const std::string&, std::vector<std::string>&);
-        //File tokenizer function
-        void tokenizeFile(std::vector<std::string>&, std::vector<std::vector<std::pair<std::string, LexerConstants::TokenType>>>&);
-        //Line tokenizer helper function
-        std::vector<std::pair<std::string, LexerConstants::TokenType>> tokenizeLine(std::string&);
-        //Dictionary of tokens
-        std::unordered_map<std::string, LexerConstants::TokenType> m_tokenDictionary;
+        //Chunk lexer function (appends the chunk's lines and tokens, lexing byte ranges of it in parallel)
+        void lexChunk(const char*, std::size_t, std::vector<std::string_view>&, TokenStream&);
+        //Give every distinct label a dense symbol ID, stored in the payload of each of its tokens
+        void internLabels(TokenStream&);
+        //Line tokenizer helper function (appends the line's token records)
+        void tokenizeLine(std::string_view, std::vector<TokenStream::Token>&);
+        //String literal checker helper function
+        bool isStringLiteral(std::string_view operandString) const;
+        //Classifier used for tokens not in the keyword table
+        LexerConstants::ClassifierMode m_classifierMode;
+        //Regex templates (only built in regex mode)
         std::vector<std::pair<std::regex, LexerConstants::TokenType>> m_operandDictionary;
         std::regex m_stringTemplate;
 };
 
-#endif
\ No newline at end of file
+#endif
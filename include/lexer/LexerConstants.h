@@ -0,0 +1,12 @@
+#ifndef LEXERCONSTANTS_H
+#define LEXERCONSTANTS_H
+
+#include <cstdint>
+
+namespace LexerConstants {
+    //Stored in a byte in token records
+    enum TokenType : uint8_t {INSTRUCTION, CONJUNCTION, JUMPCONDITION, TYPECONDITION, SHIFTCONDITION, REGISTER, INSTRUCTIONADDRESS, MEMORYADDRESS, INTEGER, FLOAT, BOOLEAN, CHARACTER, LABEL, STRING, BLANK, NEWLINE, UNKNOWN};
+    enum ClassifierMode {REGEX, DFA};
+}
+
+#endif
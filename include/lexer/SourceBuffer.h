@@ -0,0 +1,39 @@
+#ifndef SOURCEBUFFER_H
+#define SOURCEBUFFER_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+//Read-only memory mapping of a source file. Lines and tokens are views into this buffer, so it must outlive them
+class SourceBuffer {
+    public:
+        SourceBuffer() = default;
+        ~SourceBuffer();
+        //Delete copy and assignment
+        SourceBuffer(const SourceBuffer&) = delete;
+        SourceBuffer& operator=(const SourceBuffer&) = delete;
+
+        //Map a file into memory, replacing any previous mapping
+        bool open(const std::string& filename);
+        //Unmap the current file
+        void close();
+
+        //Accessors
+        const char* data() const { return m_data; }
+        std::size_t size() const { return m_size; }
+        std::string_view view() const { return {m_data, m_size}; }
+
+        //End of the chunk starting at offset - the first line end at or past chunkSize bytes (or the end of the file)
+        std::size_t chunkEnd(std::size_t offset, std::size_t chunkSize) const;
+        //Ask the kernel to start reading a range in the background
+        void prefetch(std::size_t offset, std::size_t length) const;
+        //Fault a range into memory (blocks until it is read)
+        void load(std::size_t offset, std::size_t length) const;
+
+    private:
+        const char* m_data = nullptr;
+        std::size_t m_size = 0;
+};
+
+#endif
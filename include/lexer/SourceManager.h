@@ -0,0 +1,49 @@
+#ifndef SOURCEMANAGER_H
+#define SOURCEMANAGER_H
+
+#include "lexer/SourceBuffer.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+
+//Position in the source, 1-based as diagnostics print it
+struct SourceLocation {
+    int line;
+    int column;
+};
+
+//The source of one compile - the memory mapped file and its line index. The lexer fills it in once, after which it
+//is read-only and shared by reference with every pass. Lines, tokens and tree node values are all views into the
+//mapping, so the source is never copied and must outlive them
+class SourceManager {
+    public:
+        SourceManager() = default;
+        ~SourceManager() = default;
+        //Delete copy and assignment
+        SourceManager(const SourceManager&) = delete;
+        SourceManager& operator=(const SourceManager&) = delete;
+
+        //Map a file, dropping any previous one and its line index
+        bool open(const std::string& filename);
+
+        //Accessors
+        [[nodiscard]] const std::string& filename() const { return m_filename; }
+        [[nodiscard]] const SourceBuffer& buffer() const { return m_buffer; }
+        [[nodiscard]] std::size_t numLines() const { return m_lines.size(); }
+        //Line by index (0-based), without its line ending
+        [[nodiscard]] std::string_view line(std::size_t index) const { return m_lines[index]; }
+        [[nodiscard]] const std::vector<std::string_view>& lines() const { return m_lines; }
+        //Location of a position inside one of the lines
+        [[nodiscard]] SourceLocation location(const char* position) const;
+
+    private:
+        //The lexer indexes the lines as it reads the file
+        friend class Lexer;
+        SourceBuffer m_buffer;
+        std::vector<std::string_view> m_lines;
+        std::string m_filename;
+};
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef TOKENSTREAM_H
+#define TOKENSTREAM_H
+
+#include "lexer/LexerConstants.h"
+#include "lang/OperandValue.h"
+
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+//Flat token storage for a whole file. Every token is a fixed-size record in one contiguous array, and line i owns
+//the records between lineStarts[i] and lineStarts[i+1]. Token text is never copied - records point into the lines
+class TokenStream {
+    public:
+        //Token record - where the token text starts relative to its line, its length, its decoded numeric payload
+        //(operands only) and its type
+        struct Token {
+            uint32_t offset;
+            uint32_t length;
+            OperandPayload payload;
+            LexerConstants::TokenType type;
+            bool overflow;
+        };
+
+        //Non-owning view of the tokens on one line
+        class Line {
+            public:
+                Line(const char* lineStart, const Token* tokens, std::size_t size) : m_lineStart(lineStart), m_tokens(tokens), m_size(size) {}
+
+                [[nodiscard]] std::size_t size() const {
+                    return m_size;
+                }
+                [[nodiscard]] std::string_view text(std::size_t index) const {
+                    return {m_lineStart + m_tokens[index].offset, m_tokens[index].length};
+                }
+                //Where the token text starts in its line
+                [[nodiscard]] uint32_t offset(std::size_t index) const {
+                    return m_tokens[index].offset;
+                }
+                [[nodiscard]] LexerConstants::TokenType type(std::size_t index) const {
+                    return m_tokens[index].type;
+                }
+                [[nodiscard]] OperandValue value(std::size_t index) const {
+                    return {m_tokens[index].payload, m_tokens[index].overflow};
+                }
+                //Token text and type, in the same shape the lexer has always handed out
+                std::pair<std::string_view, LexerConstants::TokenType> operator[](std::size_t index) const {
+                    return {text(index), type(index)};
+                }
+
+            private:
+                const char* m_lineStart;
+                const Token* m_tokens;
+                std::size_t m_size;
+        };
+
+        TokenStream() = default;
+        ~TokenStream() = default;
+        //Delete copy and assignment
+        TokenStream(const TokenStream&) = delete;
+        TokenStream& operator=(const TokenStream&) = delete;
+
+        //Accessors
+        [[nodiscard]] std::size_t numLines() const {
+            return m_lineStarts.empty() ? 0 : m_lineStarts.size() - 1;
+        }
+        [[nodiscard]] std::size_t numTokens() const {
+            return m_tokens.size();
+        }
+        [[nodiscard]] Line line(std::size_t index) const {
+            return {(*m_lines)[index].data(), m_tokens.data() + m_lineStarts[index], m_lineStarts[index + 1] - m_lineStarts[index]};
+        }
+        //Labels interned by the lexer - every label token's payload is a dense ID into this list
+        [[nodiscard]] std::size_t numSymbols() const {
+            return m_symbols.size();
+        }
+        [[nodiscard]] std::string_view symbolName(uint32_t symbol) const {
+            return m_symbols[symbol];
+        }
+        //Bytes held by the stream (records, line index and symbol names)
+        [[nodiscard]] std::size_t memoryUsage() const {
+            return m_tokens.capacity() * sizeof(Token) + m_lineStarts.capacity() * sizeof(uint32_t) + m_symbols.capacity() * sizeof(std::string_view);
+        }
+
+    private:
+        //Filled in by the lexer
+        friend class Lexer;
+        //Lines the token offsets are relative to
+        const std::vector<std::string_view>* m_lines = nullptr;
+        std::vector<Token> m_tokens;
+        std::vector<uint32_t> m_lineStarts;
+        //Label text by symbol ID (views into the lines)
+        std::vector<std::string_view> m_symbols;
+};
+
+#endif
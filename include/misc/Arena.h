@@ -0,0 +1,66 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <new>
+#include <cstddef>
+
+//Bump allocator for tree nodes. Memory is carved out of large blocks and only ever released all at once, so dropping
+//a whole tree is a handful of block frees. Destructors of objects in the arena are never run - anything allocated
+//here must not own other memory (use views into the arena instead of strings and vectors)
+//Every OpenMP thread bumps its own pool, so worker threads allocate without locking. Allocation is only safe from
+//the thread that created the arena and its OpenMP workers
+class Arena {
+    public:
+        explicit Arena(std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+        ~Arena();
+        //Delete copy and assignment
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        //Allocate raw memory from the calling thread's pool
+        void* allocate(std::size_t size, std::size_t alignment);
+        //Construct an object in the arena
+        template <typename T, typename... Args>
+        T* create(Args&&... args) {
+            return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+        //Uninitialized array in the arena
+        template <typename T>
+        T* allocateArray(std::size_t count) {
+            return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        }
+        //Copy a string into the arena, returning a view of the copy
+        std::string_view copyString(std::string_view text);
+
+        //Free every block at once
+        void release();
+
+        //Statistics, summed over all threads
+        [[nodiscard]] std::size_t numAllocations() const;
+        [[nodiscard]] std::size_t numBlocks() const;
+        [[nodiscard]] std::size_t bytesAllocated() const;
+
+        static constexpr std::size_t DEFAULT_BLOCK_SIZE = 1 << 20;
+
+    private:
+        //Per-thread bump state, padded to its own cache line
+        struct alignas(64) Pool {
+            char* cursor = nullptr;
+            char* end = nullptr;
+            std::vector<char*> blocks;
+            std::size_t numAllocations = 0;
+            std::size_t bytesAllocated = 0;
+        };
+
+        std::size_t m_blockSize;
+        std::vector<Pool> m_pools;
+
+        Pool& localPool();
+        //Start a new block large enough for size bytes at the given alignment
+        void grow(Pool& pool, std::size_t size, std::size_t alignment);
+};
+
+#endif
@@ -2,15 +2,48 @@
 #define PARSER_H
 
 #include "pt/ParseTree.h"
+#include "ast/AbstractSyntaxTree.h"
+#include "ast/ASTBuilder.h"
+#include "ast/Program.h"
 #include "lexer/Lexer.h"
+#include "lang/Keywords.h"
+#include "symbolres/SymbolResolver.h"
+#include "diagnostics/DiagnosticEngine.h"
 
 #include <string>
+#include <string_view>
 #include <vector>
-#include <unordered_map>
-#include <unordered_set>
-#include <iostream>
-#include <functional>
-#include <regex>
+#include <utility>
+
+namespace ParserConstants {
+    enum ErrorCode {VALID, UNKNOWN_INSTRUCTION, MISSING_PARSING_METHOD, EXCESS_TOKENS, MISSING_CONJUNCTION, UNKNOWN_CONJUNCTION, MISSING_CONDITION, UNKNOWN_CONDITION, MISSING_OPERAND, UNKNOWN_OPERAND, MISSING_DESCRIPTOR, UNKNOWN_DESCRIPTOR};
+}
+
+//Syntax error found on a line. Only the code and position are recorded - it becomes a diagnostic once the line is done
+struct SyntaxError {
+    ParserConstants::ErrorCode code = ParserConstants::VALID;
+    //Index of the token the error is at
+    int index = 0;
+    //Keyword the parsing template expected (conjunction and condition errors)
+    std::string_view expected;
+};
+
+//What a valid line's parsing template matched - the instruction keyword and its operands in order, each with the
+//conjunction or condition in front of it. Either tree is built from this once the line is known to be valid
+struct ParsedLine {
+    struct Operand {
+        //Conjunction or condition keyword, and its token index (IMPLICIT_INDEX if implicit)
+        std::string_view keyword;
+        int keywordIndex;
+        //Token index of the operand or descriptor
+        int index;
+        bool descriptor;
+    };
+    //Null for a blank line
+    const Keywords::Keyword* keyword = nullptr;
+    Operand operands[3];
+    int numOperands = 0;
+};
 
 class Parser {
     public:
@@ -22,34 +55,55 @@ class Parser {
         Parser(const Parser&) = delete;
         Parser& operator=(const Parser&) = delete;
 
-        //Parser main method
-        bool parseCode(PT::ParseTree* parseTree, const std::vector<std::string>& codeLines, const std::vector<std::vector<std::pair<std::string, LexerConstants::TokenType>>>& tokens, std::string& errorMessage);
+        //Parser main method (two-tree path, builds the parse tree the ASTBuilder converts). Every path records label
+        //declarations and label operands into the label table, for the symbol resolver to fix up
+        bool parseCode(PT::ParseTree* parseTree, LabelTable& labelTable, const TokenStream& tokens, DiagnosticEngine& diagnostics);
+        //Fused path - emits AST nodes directly
+        bool parseCodeToAST(AST::AbstractSyntaxTree* abstractSyntaxTree, const ASTBuilder& builder, LabelTable& labelTable, const TokenStream& tokens, DiagnosticEngine& diagnostics);
+        //Dense path - fills the structure-of-arrays program instead of a tree
+        bool parseCodeToProgram(AST::Program* program, LabelTable& labelTable, const TokenStream& tokens, DiagnosticEngine& diagnostics);
 
     private:
-        //Hash map containing a keyword linked to an instruction parsing function
-        std::unordered_map<std::string, std::vector<std::pair<std::pair<std::string, int>, std::function<std::string(PT::ParseTree*, PT::PTNode*, std::vector<std::pair<std::string, LexerConstants::TokenType>>, std::string&, int)>>>> m_templateMap;
-        //Hash map containing instructions with template info
-        std::unordered_map<std::string, int> m_instructionMap;
+        //Shared driver - parses every line in parallel and hands each valid one to emitLine (called from worker threads
+        //as emitLine(line, parsedLine, tokens)). Templated on the emitter so each path's builder inlines into the loop
+        template <typename Emit>
+        static bool parseLines(const TokenStream& tokens, DiagnosticEngine& diagnostics, Emit&& emitLine);
+        //Label side tables of one parsing thread
+        struct ThreadLabels {
+            std::vector<SymbolTable::Declaration> definitions;
+            std::vector<LabelReference> uses;
+        };
+        //Per-thread label tables, merged in thread order (so in line order) once every line is parsed
+        static void mergeLabels(std::vector<ThreadLabels>& threadLabels, LabelTable& labelTable);
+        //Record a label operand (and the declaration, for a label instruction)
+        static void recordLabel(ThreadLabels& labels, const ParsedLine& parsedLine, int line, int pos, uint32_t symbol, AST::OperandNode* operand);
+        //Tree builders for a valid line
+        static PT::PTNode* buildPTLine(Arena& arena, ThreadLabels& labels, int line, const ParsedLine& parsedLine, const TokenStream::Line& tokens);
+        static void buildProgramLine(AST::Program* program, ThreadLabels& labels, int line, const ParsedLine& parsedLine, const TokenStream::Line& tokens);
+        static AST::InstructionNode* buildASTLine(AST::AbstractSyntaxTree* abstractSyntaxTree, const ASTBuilder& builder, ThreadLabels& labels, int line, const ParsedLine& parsedLine, const TokenStream::Line& tokens);
+
+        //Diagnostic for a line's syntax error - the texts it names are views into the line
+        static Diagnostic syntaxDiagnostic(int line, const SyntaxError& error, const TokenStream::Line& tokens);
 
         //LEVEL 1 - INSTRUCTION CHECKERS AND PARSERS
-        std::string checkInstruction(PT::ParseTree* parseTree, std::vector<std::pair<std::string, LexerConstants::TokenType>> tokens);
-        std::string parseInstruction(PT::ParseTree* parseTree, PT::PTNode* node, std::vector<std::pair<std::string, LexerConstants::TokenType>> tokens, std::vector<std::pair<std::pair<std::string, int>, std::function<std::string(PT::ParseTree*, PT::PTNode*, std::vector<std::pair<std::string, LexerConstants::TokenType>>, std::string&, int)>>> parsingTemplate);
+        static SyntaxError checkInstruction(ParsedLine& parsedLine, const TokenStream::Line& tokens);
+        static SyntaxError parseInstruction(ParsedLine& parsedLine, const TokenStream::Line& tokens, const Keywords::Grammar& grammar);
 
         //LEVEL 2 - IMPLICIT AND EXPLICIT CONJUNCTION AND CONDITION CHECKERS
-        static std::string checkImplicitConjunction(PT::ParseTree* parseTree, PT::PTNode* node, std::vector<std::pair<std::string, LexerConstants::TokenType>> tokens, std::string& keyword, int index);
-        static std::string checkImplicitCondition(PT::ParseTree* parseTree, PT::PTNode* node, std::vector<std::pair<std::string, LexerConstants::TokenType>> tokens, std::string& keyword, int index);
-        static std::string checkExplicitConjunction(PT::ParseTree* parseTree, PT::PTNode* node, std::vector<std::pair<std::string, LexerConstants::TokenType>> tokens, std::string& keyword, int index);
-        static std::string checkExplicitCondition(PT::ParseTree* parseTree, PT::PTNode* node, std::vector<std::pair<std::string, LexerConstants::TokenType>> tokens, std::string& keyword, int index);
+        static SyntaxError checkImplicitConjunction(ParsedLine& parsedLine, const TokenStream::Line& tokens, std::string_view keyword, int index);
+        static SyntaxError checkImplicitCondition(ParsedLine& parsedLine, const TokenStream::Line& tokens, std::string_view keyword, int index);
+        static SyntaxError checkExplicitConjunction(ParsedLine& parsedLine, const TokenStream::Line& tokens, std::string_view keyword, int index);
+        static SyntaxError checkExplicitCondition(ParsedLine& parsedLine, const TokenStream::Line& tokens, std::string_view keyword, int index);
 
         //LEVEL 2 - CONJUNCTION AND CONDITION PARSERS
-        static std::string parseConjunction(PT::ParseTree* parseTree, PT::PTNode* node, std::vector<std::pair<std::string, LexerConstants::TokenType>> tokens, std::string& keyword, int index);
-        static std::string parseCondition(PT::ParseTree* parseTree, PT::PTNode* node, std::vector<std::pair<std::string, LexerConstants::TokenType>> tokens, std::string& keyword, int index);
+        static SyntaxError parseConjunction(ParsedLine& parsedLine, const TokenStream::Line& tokens, std::string_view keyword, int keywordIndex, int index);
+        static SyntaxError parseCondition(ParsedLine& parsedLine, const TokenStream::Line& tokens, std::string_view keyword, int keywordIndex, int index);
 
 
 
         //LEVEL 3 - OPERAND AND DESCRIPTOR CHECKERS
-        static bool isOperand(std::pair<std::string, LexerConstants::TokenType>& token);
-        static bool isDescriptor(std::pair<std::string, LexerConstants::TokenType>& token);
+        static bool isOperand(LexerConstants::TokenType tokenType);
+        static bool isDescriptor(LexerConstants::TokenType tokenType);
 
         //Constants helper function
         static PTConstants::OperandType returnPTOperand(LexerConstants::TokenType tokenType);
@@ -0,0 +1,62 @@
+#ifndef STARTASM_PASSMANAGER_H
+#define STARTASM_PASSMANAGER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+#include "ast/AbstractSyntaxTree.h"
+#include "diagnostics/DiagnosticEngine.h"
+
+//Scratch state a pass keeps for one worker thread while it analyzes ranges of instructions
+class PassContext {
+public:
+    virtual ~PassContext() = default;
+};
+
+//Analysis pass over a frozen AST. The pass manager hands each worker thread contiguous ranges of instructions along
+//with that thread's own context, so a pass can amortize setup over a batch and keep per-thread state without locking
+class Pass {
+public:
+    virtual ~Pass() = default;
+
+    //Prepare per-run state (called once, before any instruction is analyzed). The cutoff is shared by every pass of
+    //the run - instructions past it need not be analyzed, and a pass updates it as it raises diagnostics
+    virtual void begin(DiagnosticCutoff& /*cutoff*/) {}
+    //Create the context for one worker thread (nullptr if the pass keeps no per-thread state)
+    virtual std::unique_ptr<PassContext> createContext() { return nullptr; }
+    //Analyze the instructions in [begin, end) - called concurrently for disjoint ranges, each with its thread's context
+    virtual void visitRange(AST::ASTNode* const* begin, AST::ASTNode* const* end, PassContext* context) = 0;
+    //Fold a thread's context back into the pass (called serially, in thread order, after every range is done)
+    virtual void mergeContext(PassContext* /*context*/) {}
+    //Hand over this pass's diagnostics - one buffer per thread, each in line order
+    virtual void finish(std::vector<DiagnosticBuffer>& diagnostics) = 0;
+};
+
+//Runs every registered pass over the instructions in one parallel sweep, so the tree is streamed from memory once
+//however many passes there are. Each thread takes one contiguous block of instructions and feeds it to the passes
+//a batch at a time, so a batch is still in cache when the next pass visits it
+class PassManager {
+public:
+    //Constructor/destructor
+    PassManager() = default;
+    ~PassManager() = default;
+    //Delete copy and assignment
+    PassManager(const PassManager&) = delete;
+    PassManager& operator=(const PassManager&) = delete;
+
+    //Register a pass (not owned). Passes see each batch in registration order, and diagnostics on a shared line are
+    //reported in that order
+    void addPass(Pass* pass);
+    //Run every pass over the tree, returning false if any pass reported errors
+    bool run(AST::RootNode* root, DiagnosticEngine& diagnostics);
+
+private:
+    //Instructions handed to the passes at a time
+    static constexpr std::size_t BATCH_SIZE = 256;
+
+    std::vector<Pass*> m_passes;
+};
+
+#endif //STARTASM_PASSMANAGER_H
@@ -4,9 +4,13 @@
 #include <vector>
 #include <algorithm>
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <functional>
 
+#include "lang/OperandValue.h"
+#include "misc/Arena.h"
+
 namespace PTConstants {
     enum NodeType {ROOT, GENERAL, OPERAND};
     enum GeneralType {INSTRUCTION, CONJUNCTION, BLANK};
@@ -17,31 +21,36 @@ namespace PTConstants {
 };
 
 namespace PT {
+    // Nodes live in their tree's arena and are never destroyed individually - values are views and child lists are
+    // arrays in the arena, sized up front with reserveChildren
     class PTNode {
     public:
-        PTNode(int tokenIndex, std::string nodeValue, PTConstants::NodeType nodeType);
-        virtual ~PTNode();
+        PTNode(int tokenIndex, std::string_view nodeValue, PTConstants::NodeType nodeType);
+        virtual ~PTNode() = default;
         PTNode(const PTNode&) = delete;
         PTNode& operator=(const PTNode&) = delete;
 
-        const std::string getNodeValue() const { return m_nodeValue; }
+        const std::string getNodeValue() const { return std::string(m_nodeValue); }
+        std::string_view getNodeView() const { return m_nodeValue; }
         const PTConstants::NodeType getNodeType() const { return m_nodeType; }
         const int getIndex() const { return m_tokenIndex; }
-        const int getNumChildren() const { return m_children.size(); }
-        const std::vector<PTNode*>& getChildren() const { return m_children; }
+        const int getNumChildren() const { return m_numChildren; }
 
-        void setNodeValue(std::string value) { m_nodeValue = value; }
+        //Value must live as long as the tree
+        void setNodeValue(std::string_view value) { m_nodeValue = value; }
 
+        //Returns nullptr if the child is null or the reserved child list is full
         PTNode* insertChild(PTNode* childNode);
-        void deleteLastChild();
-        PTNode* childAt(int index);
-        void reserveChildren(int numChildren) { m_children.reserve(numChildren); }
+        PTNode* childAt(int index) const;
+        void reserveChildren(Arena& arena, int numChildren);
 
     protected:
         int m_tokenIndex;
-        std::string m_nodeValue;
+        std::string_view m_nodeValue;
         PTConstants::NodeType m_nodeType;
-        std::vector<PTNode*> m_children;
+        PTNode** m_children = nullptr;
+        int m_numChildren = 0;
+        int m_childCapacity = 0;
     };
 
     class RootNode: public PTNode {
@@ -56,7 +65,7 @@ namespace PT {
 
     class GeneralNode: public PTNode {
     public:
-        GeneralNode(int tokenIndex, std::string nodeValue, PTConstants::GeneralType generalType);
+        GeneralNode(int tokenIndex, std::string_view nodeValue, PTConstants::GeneralType generalType);
         virtual ~GeneralNode() = default;
         GeneralNode(const GeneralNode&) = delete;
         GeneralNode& operator=(const GeneralNode&) = delete;
@@ -70,26 +79,32 @@ namespace PT {
 
     class OperandNode: public PTNode {
     public:
-        OperandNode(int tokenIndex, std::string nodeValue, PTConstants::OperandType operandType);
+        OperandNode(int tokenIndex, std::string_view nodeValue, PTConstants::OperandType operandType, const OperandValue& value = OperandValue());
         virtual ~OperandNode() = default;
         OperandNode(const OperandNode&) = delete;
         OperandNode& operator=(const OperandNode&) = delete;
 
         const PTConstants::OperandType getOperandType() const { return m_operandType; }
         void setOperandType(PTConstants::OperandType type) { m_operandType = type; }
+        const OperandValue& getValue() const { return m_value; }
+        void setValue(const OperandValue& value) { m_value = value; }
 
     private:
         PTConstants::OperandType m_operandType;
+        OperandValue m_value;
     };
 
+    // Parse tree wrapper - owns the arena every node is allocated in, so dropping the tree is a single arena release
     class ParseTree {
     public:
         ParseTree();
-        ~ParseTree();
+        ~ParseTree() = default;
         PTNode* getRoot() { return m_root; }
+        Arena& getArena() { return m_arena; }
         void printTree() const;
 
     private:
+        Arena m_arena;
         PTNode* m_root;
         void printNode(const PTNode* node, int level = 0) const;
     };
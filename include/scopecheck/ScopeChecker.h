@@ -2,80 +2,57 @@
 #define STARTASM_SCOPECHECKER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <utility>
-#include <regex>
-#include <map>
+#include <cstdint>
+#include <memory>
 
 #include "ast/Instructions.h"
 #include "ast/Operands.h"
-#include "ast/Visitor.h"
+#include "passes/PassManager.h"
+#include "ast/Program.h"
+#include "lexer/SourceManager.h"
+#include "diagnostics/DiagnosticEngine.h"
 
-class ScopeChecker: public AST::Visitor {
+class ScopeChecker: public Pass {
 public:
     //Constructor/destructor
-    explicit ScopeChecker(std::vector<std::string>& lines);
+    explicit ScopeChecker(const SourceManager& source);
     ~ScopeChecker() = default;
     //Delete copy and assignment
     ScopeChecker(const ScopeChecker&) = delete;
     ScopeChecker& operator=(const ScopeChecker&) = delete;
 
-    //Main address scope checking function
-    bool checkAddressScopes(AST::ASTNode* AST, std::string& errorMessage, const std::vector<std::string>& codeLines);
+    //Same checks over the dense program representation, raising diagnostics into one buffer per thread. Lines past
+    //the cutoff (shared with the other analysis) are skipped
+    void checkProgram(const AST::Program& program, DiagnosticCutoff& cutoff, std::vector<DiagnosticBuffer>& diagnostics);
+    //Pass interface - the compiler runs both analyses in one PassManager sweep
+    void begin(DiagnosticCutoff& cutoff) override;
+    std::unique_ptr<PassContext> createContext() override;
+    void visitRange(AST::ASTNode* const* begin, AST::ASTNode* const* end, PassContext* context) override;
+    void mergeContext(PassContext* context) override;
+    void finish(std::vector<DiagnosticBuffer>& diagnostics) override;
 
 private:
-    //Error messages map and code lines
-    std::vector<std::string> m_codeLines;
-    std::map<int, std::string> m_invalidLines;
-
-    //Regex templates
-    const std::regex registerTemplate = std::regex("r[0-9]");
-    const std::regex instructionTemplate = std::regex("i\\[[0-9]{1,9}\\]");
-    const std::regex memoryTemplate = std::regex("m<[0-9]{1,9}>");
-
-    // Visitor Methods
-    void visit(AST::RootNode& node) override {};
-
-    void visit(AST::MoveInstruction& node) override {};
-    void visit(AST::LoadInstruction& node) override {};
-    void visit(AST::StoreInstruction& node) override {};
-    void visit(AST::CreateInstruction& node) override {};
-    void visit(AST::CastInstruction& node) override {};
-    void visit(AST::AddInstruction& node) override {};
-    void visit(AST::SubInstruction& node) override {};
-    void visit(AST::MultiplyInstruction& node) override {};
-    void visit(AST::DivideInstruction& node) override {};
-    void visit(AST::OrInstruction& node) override {};
-    void visit(AST::AndInstruction& node) override {};
-    void visit(AST::NotInstruction& node) override {};
-    void visit(AST::ShiftInstruction& node) override {};
-    void visit(AST::CompareInstruction& node) override {};
-    void visit(AST::JumpInstruction& node) override {};
-    void visit(AST::CallInstruction& node) override {};
-    void visit(AST::PushInstruction& node) override {};
-    void visit(AST::PopInstruction& node) override {};
-    void visit(AST::ReturnInstruction& node) override {};
-    void visit(AST::StopInstruction& node) override {};
-    void visit(AST::InputInstruction& node) override {};
-    void visit(AST::OutputInstruction& node) override {};
-    void visit(AST::PrintInstruction& node) override {};
-    void visit(AST::LabelInstruction& node) override {};
-    void visit(AST::CommentInstruction& node) override {};
-
-    void visit(AST::RegisterOperand& node) override;
-    void visit(AST::InstructionAddressOperand& node) override;
-    void visit(AST::MemoryAddressOperand& node) override;
-    void visit(AST::IntegerOperand& node) override {};
-    void visit(AST::FloatOperand& node) override {};
-    void visit(AST::BooleanOperand& node) override {};
-    void visit(AST::CharacterOperand& node) override {};
-    void visit(AST::StringOperand& node) override {};
-    void visit(AST::NewlineOperand& node) override {};
-    void visit(AST::TypeConditionOperand& node) override {};
-    void visit(AST::ShiftConditionOperand& node) override {};
-    void visit(AST::JumpConditionOperand& node) override {};
-
+    //Errors found by one thread
+    struct ThreadContext: public PassContext {
+        DiagnosticBuffer diagnostics;
+    };
+
+    //Source being checked, and the diagnostics of each thread in thread order
+    const SourceManager& m_source;
+    std::vector<DiagnosticBuffer> m_threadDiagnostics;
+    //Line past which no more errors are needed (error limit), shared by the passes of a run
+    DiagnosticCutoff* m_cutoff = nullptr;
+
+    //Address bounds (operand payloads are decoded by the lexer)
+    static constexpr uint32_t MAX_REGISTER = 9;
+    static constexpr uint32_t MAX_ADDRESS = 999999999;
+    //Operand checks shared by the AST and program loops
+    [[nodiscard]] bool inScope(ASTConstants::OperandType type, const OperandValue& value) const;
+    [[nodiscard]] Diagnostic scopeError(int line, ASTConstants::OperandType type, const OperandValue& value, std::string_view operandText) const;
 };
 
 #endif //STARTASM_SCOPECHECKER_H
@@ -2,83 +2,65 @@
 #define SEMANTICANALYZER_H
 
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <vector>
-#include <unordered_set>
-#include <set>
-#include <map>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
 
 #include "ast/Instructions.h"
 #include "ast/Operands.h"
-#include "ast/Visitor.h"
+#include "passes/PassManager.h"
+#include "ast/Program.h"
+#include "lexer/SourceManager.h"
+#include "lang/InstructionSet.h"
+#include "diagnostics/DiagnosticEngine.h"
 
-class SemanticAnalyzer: public AST::Visitor {
+class SemanticAnalyzer: public Pass {
 public:
     // Constructor/destructor
-    SemanticAnalyzer(std::vector<std::string>& lines);
+    explicit SemanticAnalyzer(const SourceManager& source);
     ~SemanticAnalyzer() = default;
 
     // Remove copy and assignment operator
     SemanticAnalyzer(const SemanticAnalyzer&) = delete;
     SemanticAnalyzer& operator=(const SemanticAnalyzer&) = delete;
 
-    // Main Semantic Analysis Method
-    bool analyzeSemantics(AST::ASTNode *AST, std::string &errorMessage);
+    // Pass interface - the compiler runs both analyses in one PassManager sweep
+    void begin(DiagnosticCutoff& cutoff) override;
+    std::unique_ptr<PassContext> createContext() override;
+    void visitRange(AST::ASTNode* const* begin, AST::ASTNode* const* end, PassContext* context) override;
+    void mergeContext(PassContext* context) override;
+    void finish(std::vector<DiagnosticBuffer>& diagnostics) override;
+    // Same checks over the dense program representation, raising diagnostics into one buffer per thread. Lines past
+    // the cutoff (shared with the other analysis) are skipped
+    void analyzeProgram(const AST::Program& program, DiagnosticCutoff& cutoff, std::vector<DiagnosticBuffer>& diagnostics);
 
 private:
-    // Data structure to store local semantic context
-    std::vector<std::vector<ASTConstants::OperandType>> m_semanticContext;
-    // Data structure for errors
-    std::map<int, std::string> m_invalidLines;
-    // Reference to code lines
-    std::vector<std::string>& m_lines;
+    // Errors found by one thread
+    struct ThreadContext: public PassContext {
+        DiagnosticBuffer diagnostics;
+    };
 
-    // Visitor Methods
-    void visit(AST::RootNode& node) override;
-
-    void visit(AST::MoveInstruction& node) override;
-    void visit(AST::LoadInstruction& node) override;
-    void visit(AST::StoreInstruction& node) override;
-    void visit(AST::CreateInstruction& node) override;
-    void visit(AST::CastInstruction& node) override;
-    void visit(AST::AddInstruction& node) override;
-    void visit(AST::SubInstruction& node) override;
-    void visit(AST::MultiplyInstruction& node) override;
-    void visit(AST::DivideInstruction& node) override;
-    void visit(AST::OrInstruction& node) override;
-    void visit(AST::AndInstruction& node) override;
-    void visit(AST::NotInstruction& node) override;
-    void visit(AST::ShiftInstruction& node) override;
-    void visit(AST::CompareInstruction& node) override;
-    void visit(AST::JumpInstruction& node) override;
-    void visit(AST::CallInstruction& node) override;
-    void visit(AST::PushInstruction& node) override;
-    void visit(AST::PopInstruction& node) override;
-    void visit(AST::ReturnInstruction& node) override;
-    void visit(AST::StopInstruction& node) override;
-    void visit(AST::InputInstruction& node) override;
-    void visit(AST::OutputInstruction& node) override;
-    void visit(AST::PrintInstruction& node) override;
-    void visit(AST::LabelInstruction& node) override;
-    void visit(AST::CommentInstruction& node) override;
-
-    void visit(AST::RegisterOperand& node) override;
-    void visit(AST::InstructionAddressOperand& node) override;
-    void visit(AST::MemoryAddressOperand& node) override;
-    void visit(AST::IntegerOperand& node) override;
-    void visit(AST::FloatOperand& node) override;
-    void visit(AST::BooleanOperand& node) override;
-    void visit(AST::CharacterOperand& node) override;
-    void visit(AST::StringOperand& node) override;
-    void visit(AST::NewlineOperand& node) override;
-    void visit(AST::TypeConditionOperand& node) override;
-    void visit(AST::ShiftConditionOperand& node) override;
-    void visit(AST::JumpConditionOperand& node) override;
+    // Diagnostics of each thread, in thread order
+    std::vector<DiagnosticBuffer> m_threadDiagnostics;
+    // Line past which no more errors are needed (error limit), shared by the passes of a run
+    DiagnosticCutoff* m_cutoff = nullptr;
+    // Source being analyzed
+    const SourceManager& m_source;
 
     // Helper functions
-    void handleAtomicInstructionError(int line, const std::vector<ASTConstants::OperandType>& expectedTemplate, AST::InstructionNode& node); // Handle error logging for atomic instructions
-    void handleMultipleInstructionError(int line, const std::vector<std::unordered_set<ASTConstants::OperandType>>& expectedTemplate, AST::InstructionNode& node); // Handle error logging for multiple type instructions
-    std::string enumToString(ASTConstants::OperandType type); // Error logging helper function
+    static constexpr int MAX_OPERANDS = InstructionSet::MAX_OPERANDS;
+    // A line's operand types packed into one word - a bit per operand type in each operand slot
+    static uint64_t packContext(const ASTConstants::OperandType* context);
+    // Check a packed context against the instruction's operand signature (a few bitwise ops, no branches)
+    static bool matchesSignature(uint64_t packedContext, ASTConstants::InstructionType type);
+    // Report every mismatched operand of an instruction, given each operand's source text and value
+    static void instructionError(DiagnosticBuffer& diagnostics, int line, const ASTConstants::OperandType* context, ASTConstants::InstructionType type, const std::function<std::pair<std::string_view, OperandValue>(int)>& operand);
+    static std::string_view expectedOperands(ASTConstants::InstructionType type, int pos); // Expected operand types of a slot, as listed in errors
+    static std::string enumToString(ASTConstants::OperandType type); // Error logging helper function
 };
 
 #endif
@@ -3,13 +3,38 @@
 #define STARTASM_SYMBOLRESOLVER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
-#include <unordered_map>
 #include <utility>
-#include <regex>
-#include <map>
+#include <cstdint>
 
 #include "pt/ParseTree.h"
+#include "ast/AbstractSyntaxTree.h"
+#include "ast/Program.h"
+#include "lexer/TokenStream.h"
+#include "symbolres/SymbolTable.h"
+#include "diagnostics/DiagnosticEngine.h"
+
+//Label operand recorded by the parser, patched with an instruction address once every declaration is known
+struct LabelReference {
+    //Interned label ID
+    uint32_t symbol;
+    //Line index the operand is on
+    int line;
+    //AST node to patch (fused path only - the parse tree path finds the node from the line and position)
+    AST::OperandNode* operand;
+    //Operand position in its instruction
+    int pos;
+};
+
+//Label side tables the parser fills while it emits lines, so symbol resolution never has to walk the program
+struct LabelTable {
+    //Label declarations, one list per parsing thread - each in line order, and the lists themselves in line order
+    std::vector<std::vector<SymbolTable::Declaration>> definitions;
+    //Every label operand (a label instruction's own operand included), in line order. This is the backpatch list -
+    //uses may come before their declaration, so they are all patched once the definitions are in the table
+    std::vector<LabelReference> uses;
+};
 
 class SymbolResolver {
     public:
@@ -20,17 +45,22 @@ class SymbolResolver {
         SymbolResolver(const SymbolResolver&) = delete;
         SymbolResolver& operator=(const SymbolResolver&) = delete;
 
-        //Main symbol resolution function
-        bool resolveSymbols(std::unordered_map<std::string, std::pair<std::string, int>>& symbolTable, PT::PTNode* parseTree, std::string& errorMessage, const std::vector<std::string>& codeLines);
+        //Main symbol resolution function - resolves the labels the parser recorded in the parse tree. Labels resolve to
+        //the numeric address of their declaration - the token stream holds the symbol IDs the lexer interned them to,
+        //and their names for diagnostics
+        bool resolveSymbols(SymbolTable& symbolTable, PT::ParseTree* parseTree, const LabelTable& labelTable, const TokenStream& tokens, DiagnosticEngine& diagnostics);
+        //Fused path - same, directly in the AST
+        bool resolveLabels(SymbolTable& symbolTable, const LabelTable& labelTable, const TokenStream& tokens, DiagnosticEngine& diagnostics);
+        //Dense path - same, patching the program's operand slots
+        bool resolveLabels(SymbolTable& symbolTable, const LabelTable& labelTable, AST::Program& program, const TokenStream& tokens, DiagnosticEngine& diagnostics);
 
     private:
-        //Helper functions
-        void buildSymbolTable(std::unordered_map<std::string, std::pair<std::string, int>>& symbolTable, PT::PTNode* parseTree, const std::vector<std::string>& codeLines);
-        void bindSymbols(std::unordered_map<std::string, std::pair<std::string, int>>& symbolTable, PT::PTNode* parseTree, const std::vector<std::string>& codeLines);
-
-        //Error messages map
-        std::map<int, std::string> m_invalidLinesMap;
-
+        //Declares the recorded labels and patches every use in one pass over the backpatch list, calling bindReference
+        //(from worker threads, as bindReference(reference, address)) with the instruction address of every defined one.
+        //Templated on the binder so each path's patching inlines into the loop. Returns false if any label was declared
+        //twice or never declared
+        template <typename Bind>
+        static bool bindReferences(SymbolTable& symbolTable, const LabelTable& labelTable, const TokenStream& tokens, DiagnosticEngine& diagnostics, Bind&& bindReference);
 };
 
 #endif //STARTASM_SYMBOLRESOLVER_H
@@ -0,0 +1,49 @@
+#ifndef STARTASM_SYMBOLTABLE_H
+#define STARTASM_SYMBOLTABLE_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+//Label table, indexed by the symbol IDs the lexer interns labels to. Each entry is the line the label is declared on,
+//so resolving a label is a single array read, safe from any number of threads once declared
+class SymbolTable {
+    public:
+        //Entry of a label that was never declared
+        static constexpr int UNDECLARED = -1;
+
+        //A label instruction seen while scanning the program
+        struct Declaration {
+            uint32_t symbol;
+            int line;
+        };
+        //A declaration of a label that was already declared on an earlier line
+        struct Duplicate {
+            uint32_t symbol;
+            int line;
+            int declaredLine;
+        };
+
+        //Constructor/destructor
+        SymbolTable() = default;
+        ~SymbolTable() = default;
+        //Delete copy and assignment
+        SymbolTable(const SymbolTable&) = delete;
+        SymbolTable& operator=(const SymbolTable&) = delete;
+
+        //Size for a number of interned labels, none of them declared
+        void reset(std::size_t numSymbols);
+        //Declare labels collected by several threads - each list in line order, and the lists themselves in line
+        //order. The first declaration of a label in line order is kept, and every later one is returned as a duplicate
+        void declare(const std::vector<std::vector<Declaration>>& declarationLists, std::vector<Duplicate>& duplicates);
+        //Declaration line of a label (UNDECLARED if it was never declared)
+        [[nodiscard]] int find(uint32_t symbol) const { return m_lines[symbol]; }
+        //Number of declared labels
+        [[nodiscard]] std::size_t size() const { return m_numDeclared; }
+
+    private:
+        std::vector<int> m_lines;
+        std::size_t m_numDeclared = 0;
+};
+
+#endif //STARTASM_SYMBOLTABLE_H
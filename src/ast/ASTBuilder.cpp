@@ -1,63 +1,44 @@
 #include "ast/ASTBuilder.h"
 #include <vector>
+#include <array>
+#include <utility>
+#include <cstddef>
 
 using namespace std;
 
-ASTBuilder::ASTBuilder() {
-    initializeFactoryMaps();
-}
+//Node factories, one per opcode and operand type, generated at compile time from the node templates so building a node
+//is a single indexed call
+namespace {
+    using InstructionFactory = AST::InstructionNode* (*)(Arena&, std::string_view, int);
+    using OperandFactory = AST::OperandNode* (*)(Arena&, std::string_view, int, short int, const OperandValue&);
+
+    template <ASTConstants::InstructionType Type>
+    AST::InstructionNode* createInstruction(Arena& arena, std::string_view value, int line) {
+        return arena.create<AST::Instruction<Type>>(value, line);
+    }
+    template <ASTConstants::OperandType Type>
+    AST::OperandNode* createOperand(Arena& arena, std::string_view value, int line, short int pos, const OperandValue& operandValue) {
+        return arena.create<AST::Operand<Type>>(value, line, pos, operandValue);
+    }
 
-void ASTBuilder::initializeFactoryMaps() {
-    //Factory map for creating instruction nodes
-    instructionFactoryMap = {
-            {ASTConstants::MOVE, [](const std::string& value, int line) { return new AST::MoveInstruction(value, line); }},
-            {ASTConstants::LOAD, [](const std::string& value, int line) { return new AST::LoadInstruction(value, line); }},
-            {ASTConstants::STORE, [](const std::string& value, int line) { return new AST::StoreInstruction(value, line); }},
-            {ASTConstants::CREATE, [](const std::string& value, int line) { return new AST::CreateInstruction(value, line); }},
-            {ASTConstants::CAST, [](const std::string& value, int line) { return new AST::CastInstruction(value, line); }},
-            {ASTConstants::ADD, [](const std::string& value, int line) { return new AST::AddInstruction(value, line); }},
-            {ASTConstants::SUB, [](const std::string& value, int line) { return new AST::SubInstruction(value, line); }},
-            {ASTConstants::MULTIPLY, [](const std::string& value, int line) { return new AST::MultiplyInstruction(value, line); }},
-            {ASTConstants::DIVIDE, [](const std::string& value, int line) { return new AST::DivideInstruction(value, line); }},
-            {ASTConstants::OR, [](const std::string& value, int line) { return new AST::OrInstruction(value, line); }},
-            {ASTConstants::AND, [](const std::string& value, int line) { return new AST::AndInstruction(value, line); }},
-            {ASTConstants::NOT, [](const std::string& value, int line) { return new AST::NotInstruction(value, line); }},
-            {ASTConstants::SHIFT, [](const std::string& value, int line) { return new AST::ShiftInstruction(value, line); }},
-            {ASTConstants::COMPARE, [](const std::string& value, int line) { return new AST::CompareInstruction(value, line); }},
-            {ASTConstants::JUMP, [](const std::string& value, int line) { return new AST::JumpInstruction(value, line); }},
-            {ASTConstants::CALL, [](const std::string& value, int line) { return new AST::CallInstruction(value, line); }},
-            {ASTConstants::PUSH, [](const std::string& value, int line) { return new AST::PushInstruction(value, line); }},
-            {ASTConstants::POP, [](const std::string& value, int line) { return new AST::PopInstruction(value, line); }},
-            {ASTConstants::RETURN, [](const std::string& value, int line) { return new AST::ReturnInstruction(value, line); }},
-            {ASTConstants::STOP, [](const std::string& value, int line) { return new AST::StopInstruction(value, line); }},
-            {ASTConstants::INPUT, [](const std::string& value, int line) { return new AST::InputInstruction(value, line); }},
-            {ASTConstants::OUTPUT, [](const std::string& value, int line) { return new AST::OutputInstruction(value, line); }},
-            {ASTConstants::PRINT, [](const std::string& value, int line) { return new AST::PrintInstruction(value, line); }},
-            {ASTConstants::LABEL, [](const std::string& value, int line) { return new AST::LabelInstruction(value, line); }},
-            {ASTConstants::COMMENT, [](const std::string& value, int line) { return new AST::CommentInstruction(value, line); }},
-    };
+    template <std::size_t... Types>
+    constexpr std::array<InstructionFactory, sizeof...(Types)> instructionFactories(std::index_sequence<Types...>) {
+        return {&createInstruction<static_cast<ASTConstants::InstructionType>(Types)>...};
+    }
+    template <std::size_t... Types>
+    constexpr std::array<OperandFactory, sizeof...(Types)> operandFactories(std::index_sequence<Types...>) {
+        return {&createOperand<static_cast<ASTConstants::OperandType>(Types)>...};
+    }
 
-    //Factory map for creating operand nodes
-    operandFactoryMap = {
-            {ASTConstants::REGISTER, [](const std::string& value, int line, short int pos) { return new AST::RegisterOperand(value, line, pos); }},
-            {ASTConstants::INSTRUCTIONADDRESS, [](const std::string& value, int line, short int pos) { return new AST::InstructionAddressOperand(value, line, pos); }},
-            {ASTConstants::MEMORYADDRESS, [](const std::string& value, int line, short int pos) { return new AST::MemoryAddressOperand(value, line, pos); }},
-            {ASTConstants::INTEGER, [](const std::string& value, int line, short int pos) { return new AST::IntegerOperand(value, line, pos); }},
-            {ASTConstants::FLOAT, [](const std::string& value, int line, short int pos) { return new AST::FloatOperand(value, line, pos); }},
-            {ASTConstants::BOOLEAN, [](const std::string& value, int line, short int pos) { return new AST::BooleanOperand(value, line, pos); }},
-            {ASTConstants::CHARACTER, [](const std::string& value, int line, short int pos) { return new AST::CharacterOperand(value, line, pos); }},
-            {ASTConstants::STRING, [](const std::string& value, int line, short int pos) { return new AST::StringOperand(value, line, pos); }},
-            {ASTConstants::NEWLINE, [](const std::string& value, int line, short int pos) { return new AST::NewlineOperand(value, line, pos); }},
-            {ASTConstants::TYPECONDITION, [](const std::string& value, int line, short int pos) { return new AST::TypeConditionOperand(value, line, pos); }},
-            {ASTConstants::SHIFTCONDITION, [](const std::string& value, int line, short int pos) { return new AST::ShiftConditionOperand(value, line, pos); }},
-            {ASTConstants::JUMPCONDITION, [](const std::string& value, int line, short int pos) { return new AST::JumpConditionOperand(value, line, pos); }},
-    };
+    //Every opcode before NONE, and every operand type before UNKNOWN, has a node class
+    constexpr auto INSTRUCTION_FACTORIES = instructionFactories(std::make_index_sequence<InstructionSet::NUM_INSTRUCTIONS>());
+    constexpr auto OPERAND_FACTORIES = operandFactories(std::make_index_sequence<ASTConstants::UNKNOWN>());
 }
 
 void ASTBuilder::buildAST(PT::PTNode* parseTree, AST::AbstractSyntaxTree* abstractSyntaxTree) {
     int PTSize = parseTree->getNumChildren();
     // Get the AST root node
-    AST::ASTNode* ASTRoot = abstractSyntaxTree->getRoot();
+    AST::RootNode* ASTRoot = abstractSyntaxTree->getRoot();
 
     // Vector to store AST instruction nodes
     std::vector<AST::InstructionNode*> instructionNodes(PTSize);
@@ -71,8 +52,9 @@ void ASTBuilder::buildAST(PT::PTNode* parseTree, AST::AbstractSyntaxTree* abstra
 
         // Initialize a new AST instruction node, using built-in conversion methods found in the AST class
         auto ASTInstructionNode = instructionBuilder(
-                abstractSyntaxTree->getInstructionType(PTInstructionNode->getNodeValue()),
-                PTInstructionNode->getNodeValue(),
+                abstractSyntaxTree->getArena(),
+                abstractSyntaxTree->getInstructionType(PTInstructionNode->getNodeView()),
+                PTInstructionNode->getNodeView(),
                 i + 1
         );
 
@@ -88,10 +70,12 @@ void ASTBuilder::buildAST(PT::PTNode* parseTree, AST::AbstractSyntaxTree* abstra
             if (PTOperandNode != nullptr && ASTInstructionNode != nullptr) {
                 // Add a child for the instruction node in the AST, using conversion functions from the AST as necessary
                 ASTInstructionNode->insertChild(operandBuilder(
+                        abstractSyntaxTree->getArena(),
                         abstractSyntaxTree->convertOperandType(PTOperandNode->getOperandType()),
-                        PTOperandNode->getNodeValue(),
+                        PTOperandNode->getNodeView(),
                         i+1,
-                        static_cast<short>(j)
+                        static_cast<short>(j),
+                        PTOperandNode->getValue()
                 ));
             }
         }
@@ -104,18 +88,17 @@ void ASTBuilder::buildAST(PT::PTNode* parseTree, AST::AbstractSyntaxTree* abstra
     }
 }
 
-AST::InstructionNode* ASTBuilder::instructionBuilder(ASTConstants::InstructionType nodeType, const std::string& value, int line) {
-    auto it = instructionFactoryMap.find(nodeType);
-    if (it != instructionFactoryMap.end()) {
-        return it->second(value, line);
+AST::InstructionNode* ASTBuilder::instructionBuilder(Arena& arena, ASTConstants::InstructionType nodeType, std::string_view value, int line) const {
+    if (nodeType >= INSTRUCTION_FACTORIES.size()) {
+        return nullptr;
     }
-    return nullptr;
+    //The node keeps a view into the source, which outlives the tree
+    return INSTRUCTION_FACTORIES[nodeType](arena, value, line);
 }
 
-AST::OperandNode* ASTBuilder::operandBuilder(ASTConstants::OperandType nodeType, const std::string& value, int line, short int pos) {
-    auto it = operandFactoryMap.find(nodeType);
-    if (it != operandFactoryMap.end()) {
-        return it->second(value, line, pos);
+AST::OperandNode* ASTBuilder::operandBuilder(Arena& arena, ASTConstants::OperandType nodeType, std::string_view value, int line, short int pos, const OperandValue& operandValue) const {
+    if (nodeType >= OPERAND_FACTORIES.size()) {
+        return nullptr;
     }
-    return nullptr;
+    return OPERAND_FACTORIES[nodeType](arena, value, line, pos, operandValue);
 }
@@ -1,21 +1,19 @@
 #include "ast/Instructions.h"
 #include "ast/Operands.h"
+#include "lang/Keywords.h"
 
 namespace AST {
     // ASTNode Implementation
-    ASTNode::ASTNode(ASTConstants::NodeType type, const std::string &value)
+    ASTNode::ASTNode(ASTConstants::NodeType type, std::string_view value)
             : m_nodeType(type), m_nodeValue(value) {}
 
-    ASTNode::~ASTNode() {
-        for (auto & child : m_children) {
-            delete child;
-        }
-        m_children.clear();
-    }
+    // RootNode Implementation
+    RootNode::RootNode() : ASTNode(ASTConstants::NodeType::ROOT, "") {}
+    // Instructions live in the tree's arena, which releases them all at once
+    RootNode::~RootNode() = default;
 
-    ASTNode* ASTNode::insertChild(ASTNode* childNode) {
-        if (childNode != nullptr) {
-            std::lock_guard<std::mutex> lock(m_mutex);
+    ASTNode* RootNode::insertChild(ASTNode* childNode) {
+        if (childNode != nullptr && !m_frozen) {
             m_children.push_back(childNode);
             return childNode;
         } else {
@@ -23,8 +21,7 @@ namespace AST {
         }
     }
 
-    ASTNode* ASTNode::childAt(int index) {
-        std::lock_guard<std::mutex> lock(m_mutex);
+    ASTNode* RootNode::childAt(int index) const {
         if (index >= static_cast<int>(m_children.size())) {
             return nullptr;
         } else {
@@ -32,84 +29,61 @@ namespace AST {
         }
     }
 
-    void ASTNode::reserveChildren(int numChildren) {
-        m_children.reserve(numChildren);
-    }
-
-    // RootNode Implementation
-    RootNode::RootNode() : ASTNode(ASTConstants::NodeType::ROOT, "") {}
-    RootNode::~RootNode() = default;
-
-    void RootNode::accept(AST::Visitor &visitor) {
-        //Visit for root node first (usually nothing)
-        visitor.visit(*this);
-        //Visit for all instruction children (multithreaded)
-        #pragma omp parallel for schedule(auto) default(none) shared(visitor)
-        for (auto* child : m_children) {
-            child->accept(visitor);
+    void RootNode::reserveChildren(int numChildren) {
+        if (!m_frozen) {
+            m_children.reserve(numChildren);
         }
     }
 
     // InstructionNode Implementation
-    InstructionNode::InstructionNode(const std::string &nodeValue, ASTConstants::InstructionType instructionType, ASTConstants::NumOperands numOperands, int line)
+    InstructionNode::InstructionNode(std::string_view nodeValue, ASTConstants::InstructionType instructionType, ASTConstants::NumOperands numOperands, int line)
             : ASTNode(ASTConstants::NodeType::INSTRUCTION, nodeValue), m_instructionType(instructionType), m_numOperands(numOperands), m_line(line) {}
 
     InstructionNode::~InstructionNode() = default;
 
+    ASTNode* InstructionNode::insertChild(ASTNode* childNode) {
+        //Null children and operands past the inline capacity are rejected
+        if (childNode != nullptr && m_children.push_back(childNode)) {
+            return childNode;
+        } else {
+            return nullptr;
+        }
+    }
+
+    ASTNode* InstructionNode::childAt(int index) const {
+        if (index >= m_children.size()) {
+            return nullptr;
+        } else {
+            return m_children[index];
+        }
+    }
+
     // OperandNode Implementation
-    OperandNode::OperandNode(const std::string &nodeValue, ASTConstants::OperandType operandType, int line, short int pos)
-            : ASTNode(ASTConstants::NodeType::OPERAND, nodeValue), m_operandType(operandType), m_line(line), m_pos(pos) {}
+    OperandNode::OperandNode(std::string_view nodeValue, ASTConstants::OperandType operandType, int line, short int pos, const OperandValue &value)
+            : ASTNode(ASTConstants::NodeType::OPERAND, nodeValue), m_operandType(operandType), m_value(value), m_line(line), m_pos(pos) {}
 
     OperandNode::~OperandNode() = default;
 
+    std::string OperandNode::getOperandText() const {
+        if (m_value.label) {
+            return "i[" + std::to_string(m_value.payload.address) + "]";
+        }
+        return getNodeValue();
+    }
+
     // AbstractSyntaxTree Implementation
     AbstractSyntaxTree::AbstractSyntaxTree() {
         m_root = new RootNode();
-        m_instructionDictionary.reserve(26);
-        m_instructionDictionary.emplace("move", ASTConstants::InstructionType::MOVE);
-        m_instructionDictionary.emplace("load", ASTConstants::InstructionType::LOAD);
-        m_instructionDictionary.emplace("store", ASTConstants::InstructionType::STORE);
-        m_instructionDictionary.emplace("create", ASTConstants::InstructionType::CREATE);
-        m_instructionDictionary.emplace("cast", ASTConstants::InstructionType::CAST);
-        m_instructionDictionary.emplace("add", ASTConstants::InstructionType::ADD);
-        m_instructionDictionary.emplace("sub", ASTConstants::InstructionType::SUB);
-        m_instructionDictionary.emplace("multiply", ASTConstants::InstructionType::MULTIPLY);
-        m_instructionDictionary.emplace("divide", ASTConstants::InstructionType::DIVIDE);
-        m_instructionDictionary.emplace("or", ASTConstants::InstructionType::OR);
-        m_instructionDictionary.emplace("and", ASTConstants::InstructionType::AND);
-        m_instructionDictionary.emplace("not", ASTConstants::InstructionType::NOT);
-        m_instructionDictionary.emplace("shift", ASTConstants::InstructionType::SHIFT);
-        m_instructionDictionary.emplace("compare", ASTConstants::InstructionType::COMPARE);
-        m_instructionDictionary.emplace("jump", ASTConstants::InstructionType::JUMP);
-        m_instructionDictionary.emplace("call", ASTConstants::InstructionType::CALL);
-        m_instructionDictionary.emplace("push", ASTConstants::InstructionType::PUSH);
-        m_instructionDictionary.emplace("pop", ASTConstants::InstructionType::POP);
-        m_instructionDictionary.emplace("return", ASTConstants::InstructionType::RETURN);
-        m_instructionDictionary.emplace("stop", ASTConstants::InstructionType::STOP);
-        m_instructionDictionary.emplace("input", ASTConstants::InstructionType::INPUT);
-        m_instructionDictionary.emplace("output", ASTConstants::InstructionType::OUTPUT);
-        m_instructionDictionary.emplace("print", ASTConstants::InstructionType::PRINT);
-        m_instructionDictionary.emplace("label", ASTConstants::InstructionType::LABEL);
-        m_instructionDictionary.emplace("comment", ASTConstants::InstructionType::COMMENT);
     }
 
     AbstractSyntaxTree::~AbstractSyntaxTree() {
+        //Only the root's child list is freed here - every other node goes with the arena
         delete m_root;
     }
 
-    ASTNode* AbstractSyntaxTree::getRoot() {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_root;
-    }
-
-    ASTConstants::InstructionType AbstractSyntaxTree::getInstructionType(const std::string &instruction) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        auto itr = m_instructionDictionary.find(instruction);
-        if (itr != m_instructionDictionary.end()) {
-            return itr->second;
-        } else {
-            return ASTConstants::InstructionType::NONE;
-        }
+    ASTConstants::InstructionType AbstractSyntaxTree::getInstructionType(std::string_view instruction) {
+        //Compile-time keyword table
+        return Keywords::getInstructionType(instruction);
     }
 
     ASTConstants::NumOperands AbstractSyntaxTree::getNumOperands(int num) {
@@ -168,16 +142,28 @@ namespace AST {
 
         std::string indent(level * 4, ' ');
 
-        const AST::OperandNode* operandNode = dynamic_cast<const AST::OperandNode*>(node);
-
-        if (operandNode != nullptr) {
-            std::cout << indent << node->getNodeValue() << " - OperandType: " << operandNode->getOperandType() << std::endl;
-        } else {
-            std::cout << indent << node->getNodeValue() << " (" << node->getNumChildren() << " children)" << std::endl;
-        }
-
-        for (const auto& child : node->getChildren()) {
-            printNode(child, level + 1);
+        switch (node->getNodeType()) {
+            case ASTConstants::NodeType::ROOT: {
+                const auto* rootNode = static_cast<const RootNode*>(node);
+                std::cout << indent << node->getNodeValue() << " (" << rootNode->getNumChildren() << " children)" << std::endl;
+                for (const auto& child : rootNode->getChildren()) {
+                    printNode(child, level + 1);
+                }
+                break;
+            }
+            case ASTConstants::NodeType::INSTRUCTION: {
+                const auto* instructionNode = static_cast<const InstructionNode*>(node);
+                std::cout << indent << node->getNodeValue() << " (" << instructionNode->getNumChildren() << " children)" << std::endl;
+                for (const auto& child : instructionNode->getChildren()) {
+                    printNode(child, level + 1);
+                }
+                break;
+            }
+            case ASTConstants::NodeType::OPERAND: {
+                const auto* operandNode = static_cast<const OperandNode*>(node);
+                std::cout << indent << operandNode->getOperandText() << " - OperandType: " << operandNode->getOperandType() << std::endl;
+                break;
+            }
         }
     }
 }
@@ -0,0 +1,83 @@
+#include "ast/Program.h"
+#include "lang/Keywords.h"
+
+#include <iostream>
+
+namespace AST {
+    void Program::resize(std::size_t numInstructions) {
+        m_opcodes.assign(numInstructions, ASTConstants::NONE);
+        m_numOperands.assign(numInstructions, 0);
+        m_lines.assign(numInstructions, 0);
+        m_operandTypes.assign(numInstructions * MAX_OPERANDS, ASTConstants::EMPTY);
+        m_payloads.assign(numInstructions * MAX_OPERANDS, OperandPayload{});
+        m_overflows.assign(numInstructions * MAX_OPERANDS, 0);
+        m_textOffsets.assign(numInstructions * MAX_OPERANDS, 0);
+        m_textLengths.assign(numInstructions * MAX_OPERANDS, 0);
+    }
+
+    std::string_view Program::getOperandView(std::size_t index, int pos, const SourceManager& source) const {
+        std::size_t slot = index * MAX_OPERANDS + pos;
+        if (m_textOffsets[slot] == FORMATTED_TEXT) {
+            return {};
+        }
+        return source.line(m_lines[index] - 1).substr(m_textOffsets[slot], m_textLengths[slot]);
+    }
+
+    std::string Program::getOperandText(std::size_t index, int pos, const SourceManager& source) const {
+        std::size_t slot = index * MAX_OPERANDS + pos;
+        if (m_textOffsets[slot] == FORMATTED_TEXT) {
+            return "i[" + std::to_string(m_payloads[slot].address) + "]";
+        }
+        return std::string(getOperandView(index, pos, source));
+    }
+
+    std::size_t Program::memoryUsage() const {
+        return m_opcodes.capacity() + m_numOperands.capacity() + m_lines.capacity() * sizeof(uint32_t)
+            + m_operandTypes.capacity() + m_payloads.capacity() * sizeof(OperandPayload) + m_overflows.capacity()
+            + m_textOffsets.capacity() * sizeof(uint32_t) + m_textLengths.capacity() * sizeof(uint32_t);
+    }
+
+    void Program::setInstruction(std::size_t index, ASTConstants::InstructionType opcode, int line) {
+        m_opcodes[index] = static_cast<uint8_t>(opcode);
+        m_lines[index] = static_cast<uint32_t>(line);
+    }
+
+    void Program::addOperand(std::size_t index, ASTConstants::OperandType type, const OperandValue& value, uint32_t textOffset, uint32_t textLength) {
+        //Operands past the last slot are dropped, like children past an instruction node's inline capacity
+        if (m_numOperands[index] == MAX_OPERANDS) {
+            return;
+        }
+        std::size_t slot = index * MAX_OPERANDS + m_numOperands[index]++;
+        m_operandTypes[slot] = static_cast<uint8_t>(type);
+        m_payloads[slot] = value.payload;
+        m_overflows[slot] = value.overflow;
+        m_textOffsets[slot] = textOffset;
+        m_textLengths[slot] = textLength;
+    }
+
+    void Program::resolveAddress(std::size_t index, int pos, uint32_t address) {
+        std::size_t slot = index * MAX_OPERANDS + pos;
+        m_operandTypes[slot] = static_cast<uint8_t>(ASTConstants::INSTRUCTIONADDRESS);
+        m_payloads[slot].address = address;
+        m_overflows[slot] = 0;
+        m_textOffsets[slot] = FORMATTED_TEXT;
+    }
+
+    void Program::print(const SourceManager& source) const {
+        //Blank lines have no instruction, as in the AST
+        int numInstructions = 0;
+        for (uint8_t opcode : m_opcodes) {
+            numInstructions += opcode != ASTConstants::NONE;
+        }
+        std::cout << " (" << numInstructions << " children)" << std::endl;
+        for (std::size_t i = 0; i < size(); i++) {
+            if (getOpcode(i) == ASTConstants::NONE) {
+                continue;
+            }
+            std::cout << "    " << Keywords::getInstructionName(getOpcode(i)) << " (" << getNumOperands(i) << " children)" << std::endl;
+            for (int j = 0; j < getNumOperands(i); j++) {
+                std::cout << "        " << getOperandText(i, j, source) << " - OperandType: " << getOperandType(i, j) << std::endl;
+            }
+        }
+    }
+}
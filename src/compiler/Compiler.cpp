@@ -7,34 +7,46 @@
 #include "semantics/SemanticAnalyzer.h"
 #include "scopecheck/ScopeChecker.h"
 #include "codegen/CodeGenerator.h"
+#include "passes/PassManager.h"
 
 #include <iostream>
 #include <vector>
 #include <string>
 #include <omp.h>
 #include <future>
+#include <iterator>
 
 using namespace std;
 
-Compiler::Compiler(std::string& pathname, bool cmdSilent, bool cmdTimings, bool cmdTree, bool cmdIr) :
+Compiler::Compiler(std::string& pathname, bool cmdSilent, bool cmdTimings, bool cmdTree, bool cmdIr, bool cmdTokens, bool cmdParseTree, bool cmdSoa, LexerConstants::ClassifierMode lexerMode, std::size_t maxErrors) :
     cmd_silent(cmdSilent),
     cmd_timings(cmdTimings),
     cmd_tree(cmdTree),
     cmd_ir(cmdIr),
-    m_lexer(new Lexer()),
+    cmd_tokens(cmdTokens),
+    cmd_parseTree(cmdParseTree),
+    cmd_soa(cmdSoa),
+    m_lexer(new Lexer(lexerMode)),
     m_parser(new Parser()),
-    m_parseTree(new PT::ParseTree()),
+    m_parseTree(cmdParseTree && !cmdSoa ? new PT::ParseTree() : nullptr),
+    m_program(cmdSoa ? new AST::Program() : nullptr),
     m_symbolResolver(new SymbolResolver()),
-    m_AST(new AST::AbstractSyntaxTree()),
-    m_ASTBuilder(new ASTBuilder()),
-    m_semanticAnalyzer(new SemanticAnalyzer(m_codeLines)),
-    m_scopeChecker(new ScopeChecker(m_codeLines)),
+    //The dense path never builds a tree, so it doesn't allocate one (or its arena)
+    m_AST(cmdSoa ? nullptr : new AST::AbstractSyntaxTree()),
+    m_ASTBuilder(cmdSoa ? nullptr : new ASTBuilder()),
+    m_semanticAnalyzer(new SemanticAnalyzer(m_source)),
+    m_scopeChecker(new ScopeChecker(m_source)),
     //m_codeGenerator(new CodeGenerator()),
-    m_pathname(pathname) {}
+    m_pathname(pathname) {
+    //Every stage stops once this many errors are found (0 for no limit)
+    m_diagnostics.setMaxErrors(maxErrors);
+}
 
 Compiler::~Compiler() {
     delete m_lexer;
     delete m_parser;
+    delete m_parseTree;
+    delete m_program;
     delete m_symbolResolver;
     delete m_AST;
     delete m_ASTBuilder;
@@ -59,60 +71,117 @@ bool Compiler::compileCode() {
     double start = omp_get_wtime();
     //Lex code//
     cmdTimingPrint("Compiler: Lexing code\n");
-    if (!m_lexer->lexFile(m_pathname, m_codeLines, m_codeTokens)) {
+    if (!m_lexer->lexFile(m_pathname, m_source, m_codeTokens)) {
         m_statusMessage = "Lexing failed! Either the path was invalid or the file could not be found.";
         return false;
     }
     cmdTimingPrint("Time taken: " + to_string(omp_get_wtime()-start) + "\n\n");
+    if(cmd_tokens && !cmd_silent) {
+        cout << endl;
+        cout << "Tokens for '" + m_pathname + "':\n";
+        Lexer::printTokens(m_codeTokens);
+        cout << endl;
+    }
 
     //Parse code//
     cmdTimingPrint("Compiler: Parsing code\n");
     start = omp_get_wtime();
-    if(!m_parser->parseCode(m_parseTree, m_codeLines, m_codeTokens, m_statusMessage)) {
-        return false;
+    bool parsed;
+    if (cmd_soa) {
+        //Dense path - the parser fills flat per-instruction arrays that the analysis passes loop over
+        parsed = m_parser->parseCodeToProgram(m_program, m_labelTable, m_codeTokens, m_diagnostics);
     }
+    else if (cmd_parseTree) {
+        parsed = m_parser->parseCode(m_parseTree, m_labelTable, m_codeTokens, m_diagnostics);
+    }
+    else {
+        //Fused path - the parser emits the AST directly and label operands are fixed up during symbol resolution
+        parsed = m_parser->parseCodeToAST(m_AST, *m_ASTBuilder, m_labelTable, m_codeTokens, m_diagnostics);
+    }
+    //Time is reported even when parsing fails, so the error path can be benchmarked too
     cmdTimingPrint("Time taken: " + to_string(omp_get_wtime()-start) + "\n\n");
+    if (!parsed) {
+        return false;
+    }
 
     //Resolve symbolres//
     cmdTimingPrint("Compiler: Resolving symbolres\n");
     start = omp_get_wtime();
-    if(!m_symbolResolver->resolveSymbols(m_symbolTable, m_parseTree->getRoot(), m_statusMessage, m_codeLines)) {
+    bool resolved;
+    if (cmd_soa) {
+        resolved = m_symbolResolver->resolveLabels(m_symbolTable, m_labelTable, *m_program, m_codeTokens, m_diagnostics);
+    }
+    else if (cmd_parseTree) {
+        resolved = m_symbolResolver->resolveSymbols(m_symbolTable, m_parseTree, m_labelTable, m_codeTokens, m_diagnostics);
+    }
+    else {
+        resolved = m_symbolResolver->resolveLabels(m_symbolTable, m_labelTable, m_codeTokens, m_diagnostics);
+    }
+    if(!resolved) {
         return false;
     }
     cmdTimingPrint("Time taken: " + to_string(omp_get_wtime()-start) + "\n\n");
 
-    //Delete the lexer and build the AST concurrently//
-    cmdTimingPrint("Compiler: Building AST\n");
-    start = omp_get_wtime();
-    //Delete the lexer after PT creation is finished! It's no longer needed
-    auto lexerDeletionFuture = std::async(std::launch::async, [this] {
-        delete m_lexer;
-        m_lexer = nullptr;
-    });
-    m_ASTBuilder->buildAST(m_parseTree->getRoot(), m_AST);
-    lexerDeletionFuture.get();
-    cmdTimingPrint("Time taken: " + to_string(omp_get_wtime()-start) + "\n\n");
+    //Build the AST (two-tree path only)//
+    if (cmd_parseTree && !cmd_soa) {
+        cmdTimingPrint("Compiler: Building AST\n");
+        start = omp_get_wtime();
+        m_ASTBuilder->buildAST(m_parseTree->getRoot(), m_AST);
+        //The parse tree is no longer needed - dropping it releases its arena in one go
+        delete m_parseTree;
+        m_parseTree = nullptr;
+        cmdTimingPrint("Time taken: " + to_string(omp_get_wtime()-start) + "\n\n");
+    }
+    //The AST is complete - freeze it so the passes below can traverse it without locking
+    if (m_AST != nullptr) {
+        m_AST->freeze();
+    }
+    //Delete the lexer and parser after the AST is built! They're no longer needed
+    delete m_lexer;
+    m_lexer = nullptr;
+    delete m_parser;
+    m_parser = nullptr;
     if(cmd_tree && !cmd_silent) {
         cout << endl;
         cout << "AST for '" + m_pathname + "':\n";
-        m_AST->printTree();
+        if (cmd_soa) {
+            m_program->print(m_source);
+        }
+        else {
+            m_AST->printTree();
+        }
         cout << endl;
     }
 
-    //Check address scopes and analyze semantics while deleting the parse tree concurrently//
+    //Check address scopes and analyze semantics//
     cmdTimingPrint("Compiler: Analyzing semantics and checking address scopes\n");
     start = omp_get_wtime();
-    auto parserDeletionFuture = std::async(std::launch::async, [this] {
-        delete m_parser;
-        m_parser = nullptr;
-    });
-    auto checkAddressScopesFuture = std::async(&ScopeChecker::checkAddressScopes, m_scopeChecker, m_AST->getRoot(), std::ref(m_statusMessage), std::ref(m_codeLines));
-    auto analyzeSemanticsFuture = std::async(&SemanticAnalyzer::analyzeSemantics, m_semanticAnalyzer, m_AST->getRoot(), std::ref(m_statusMessage));
-    // Wait for all tasks to complete and retrieve function results
-    bool checkAddressScopesResult = checkAddressScopesFuture.get();
-    bool analyzeSemanticsResult = analyzeSemanticsFuture.get();
-    parserDeletionFuture.get();
-    if(!checkAddressScopesResult || !analyzeSemanticsResult) {
+    bool analyzed;
+    if (cmd_soa) {
+        //Both tasks share one cutoff, and their diagnostics are reported in one merge by line (scope errors first on a
+        //shared line, as on the other paths) - so the error limit keeps the lowest-numbered ones of both
+        DiagnosticCutoff cutoff;
+        cutoff.reset(m_diagnostics.remaining());
+        vector<DiagnosticBuffer> scopeDiagnostics;
+        vector<DiagnosticBuffer> semanticDiagnostics;
+        auto checkAddressScopesFuture = std::async(&ScopeChecker::checkProgram, m_scopeChecker, std::cref(*m_program), std::ref(cutoff), std::ref(scopeDiagnostics));
+        auto analyzeSemanticsFuture = std::async(&SemanticAnalyzer::analyzeProgram, m_semanticAnalyzer, std::cref(*m_program), std::ref(cutoff), std::ref(semanticDiagnostics));
+        // Wait for all tasks to complete
+        checkAddressScopesFuture.get();
+        analyzeSemanticsFuture.get();
+        scopeDiagnostics.insert(scopeDiagnostics.end(), std::make_move_iterator(semanticDiagnostics.begin()), std::make_move_iterator(semanticDiagnostics.end()));
+        size_t numErrors = m_diagnostics.size();
+        m_diagnostics.report(scopeDiagnostics);
+        analyzed = m_diagnostics.size() == numErrors;
+    }
+    else {
+        //Both passes run over each instruction in a single sweep of the AST
+        PassManager passManager;
+        passManager.addPass(m_scopeChecker);
+        passManager.addPass(m_semanticAnalyzer);
+        analyzed = passManager.run(m_AST->getRoot(), m_diagnostics);
+    }
+    if(!analyzed) {
         return false;
     }
     cmdTimingPrint("Time taken: " + to_string(omp_get_wtime()-start) + "\n\n");
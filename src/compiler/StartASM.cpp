@@ -14,6 +14,18 @@ bool cmdOptionExists(char** begin, char** end, const string& option) {
     return find(begin, end, option) != end;
 }
 
+// Function to get the value of a command-line option given as --option=value (empty if not present)
+string getCmdOptionValue(char** begin, char** end, const string& option) {
+    string prefix = option + "=";
+    for (char** itr = begin; itr != end; itr++) {
+        string argument(*itr);
+        if (argument.compare(0, prefix.length(), prefix) == 0) {
+            return argument.substr(prefix.length());
+        }
+    }
+    return "";
+}
+
 // Function to check for valid .sasm file extension
 bool isValidSASMFile(const string& filename) {
     if (filename.length() >= 5) {
@@ -39,6 +51,11 @@ void displayHelp() {
     cout << "  --timings     Print out timings for each compilation step" << endl;
     cout << "  --tree        Print out the AST (Abstract Syntax Tree)" << endl;
     cout << "  --ir        Print out generated LLVM IR" << endl;
+    cout << "  --tokens      Print out the lexer token stream" << endl;
+    cout << "  --lexer=MODE  Operand classifier to lex with: dfa (default) or regex" << endl;
+    cout << "  --parsetree   Build the intermediate parse tree before the AST (debugging)" << endl;
+    cout << "  --soa         Analyze a dense structure-of-arrays program instead of the AST" << endl;
+    cout << "  --max-errors=N  Stop compiling once N errors are found (the first N by line are reported). Also --max-errors N" << endl;
     cout << "  --silent      Suppress output (except syntax errors)" << endl;
     cout << "  --truesilent  Suppress all output, including syntax errors" << endl;
     cout << "Note that the use of --silent or --truesilent will override output flags such as --tree and --timings." << endl;
@@ -107,9 +124,47 @@ int main(int argc, char* argv[]) {
     bool ir = cmdOptionExists(argv, argv + argc, "--ir");
     bool silent = cmdOptionExists(argv, argv + argc, "--silent") || cmdOptionExists(argv, argv + argc, "--truesilent");
     bool truesilent = cmdOptionExists(argv, argv + argc, "--truesilent");
+    bool tokens = cmdOptionExists(argv, argv + argc, "--tokens");
+    bool parseTree = cmdOptionExists(argv, argv + argc, "--parsetree");
+    bool soa = cmdOptionExists(argv, argv + argc, "--soa");
+
+    // Lexer classifier selection
+    LexerConstants::ClassifierMode lexerMode = LexerConstants::ClassifierMode::DFA;
+    string lexerOption = getCmdOptionValue(argv, argv + argc, "--lexer");
+    if (lexerOption == "regex") {
+        lexerMode = LexerConstants::ClassifierMode::REGEX;
+    }
+    else if (!lexerOption.empty() && lexerOption != "dfa") {
+        if (!truesilent) {
+            cerr << "Unknown lexer mode: " << lexerOption << endl;
+            cerr << "For usage information: startasm --help" << endl;
+        }
+        return 1;
+    }
+
+    // Error limit (0 for no limit), given as --max-errors=N or --max-errors N
+    size_t maxErrors = 0;
+    string maxErrorsOption = getCmdOptionValue(argv, argv + argc, "--max-errors");
+    // An empty or missing value (--max-errors= or a trailing --max-errors) is rejected too, rather than read as no limit
+    bool maxErrorsGiven = !maxErrorsOption.empty() || cmdOptionExists(argv, argv + argc, "--max-errors=");
+    char** maxErrorsFlag = find(argv, argv + argc, string("--max-errors"));
+    if (maxErrorsFlag != argv + argc) {
+        maxErrorsGiven = true;
+        maxErrorsOption = maxErrorsFlag + 1 != argv + argc ? *(maxErrorsFlag + 1) : "";
+    }
+    if (maxErrorsGiven) {
+        if (maxErrorsOption.empty() || maxErrorsOption.find_first_not_of("0123456789") != string::npos || maxErrorsOption.length() > 9 || stoul(maxErrorsOption) == 0) {
+            if (!truesilent) {
+                cerr << "Invalid error limit: " << maxErrorsOption << endl;
+                cerr << "For usage information: startasm --help" << endl;
+            }
+            return 1;
+        }
+        maxErrors = stoul(maxErrorsOption);
+    }
 
     // Adjust the compiler instantiation to pass the truesilent flag
-    Compiler StartASMCompiler(filepath, silent, timings, tree, ir);
+    Compiler StartASMCompiler(filepath, silent, timings, tree, ir, tokens, parseTree, soa, lexerMode, maxErrors);
     double start = omp_get_wtime();
     if (!StartASMCompiler.compileCode()) {
         if (!truesilent) {
@@ -0,0 +1,209 @@
+#include "diagnostics/DiagnosticEngine.h"
+
+#include <string>
+#include <vector>
+#include <queue>
+#include <utility>
+#include <functional>
+#include <charconv>
+#include <algorithm>
+
+using namespace std;
+using namespace DiagnosticConstants;
+
+namespace {
+    //Appends message pieces to one growing buffer - numbers are converted in place, so no temporary strings are made
+    class DiagnosticWriter {
+        public:
+            explicit DiagnosticWriter(string& buffer) : m_buffer(buffer) {}
+
+            DiagnosticWriter& operator<<(string_view text) {
+                m_buffer.append(text.data(), text.size());
+                return *this;
+            }
+            DiagnosticWriter& operator<<(char character) {
+                m_buffer.push_back(character);
+                return *this;
+            }
+            DiagnosticWriter& operator<<(size_t number) {
+                char digits[20];
+                auto result = to_chars(digits, digits + sizeof(digits), number);
+                m_buffer.append(digits, result.ptr - digits);
+                return *this;
+            }
+            //Operand text - as written, or i[n] for a resolved label
+            void operand(const Diagnostic& diagnostic) {
+                if (diagnostic.labelAddress != 0) {
+                    *this << "i[" << static_cast<size_t>(diagnostic.labelAddress) << ']';
+                }
+                else {
+                    *this << diagnostic.token;
+                }
+            }
+
+        private:
+            string& m_buffer;
+    };
+
+    bool isSemantic(Code code) {
+        return code == UNRECOGNIZED_OPERAND || code == EXTRA_OPERAND;
+    }
+}
+
+void DiagnosticEngine::report(vector<DiagnosticBuffer>& buffers) {
+    size_t total = m_diagnostics.size();
+    for (const auto& buffer : buffers) {
+        total += buffer.size();
+    }
+    if (m_maxErrors != 0) {
+        total = min(total, max(m_maxErrors, m_diagnostics.size()));
+    }
+    m_diagnostics.reserve(total);
+
+    //K-way merge - a min-heap of the next diagnostic of every buffer, ordered by line and then by buffer, so ties keep
+    //buffer order. Within a buffer the order is kept as is
+    using Cursor = pair<int, size_t>;
+    priority_queue<Cursor, vector<Cursor>, greater<Cursor>> heap;
+    vector<size_t> positions(buffers.size(), 0);
+    for (size_t i=0; i<buffers.size(); i++) {
+        if (!buffers[i].empty()) {
+            heap.emplace(buffers[i].front().line, i);
+        }
+    }
+    //The merge is in line order, so stopping at the limit keeps the lowest-numbered diagnostics
+    while (!heap.empty() && m_diagnostics.size() < total) {
+        size_t i = heap.top().second;
+        heap.pop();
+        //Take this buffer's diagnostics for as long as they come before the next one of every other buffer
+        DiagnosticBuffer& buffer = buffers[i];
+        size_t& position = positions[i];
+        do {
+            m_diagnostics.push_back(buffer[position++]);
+        } while (position < buffer.size() && m_diagnostics.size() < total && (heap.empty() || Cursor(buffer[position].line, i) < heap.top()));
+        if (position < buffer.size()) {
+            heap.emplace(buffer[position].line, i);
+        }
+    }
+    buffers.clear();
+}
+
+string DiagnosticEngine::format(const SourceManager& source) const {
+    string report;
+    //Most messages are a line of source plus a short sentence
+    report.reserve(m_diagnostics.size() * 128);
+    DiagnosticWriter writer(report);
+    const Diagnostic* previous = nullptr;
+    for (const Diagnostic& diagnostic : m_diagnostics) {
+        size_t lineNumber = static_cast<size_t>(diagnostic.line) + 1;
+        string_view lineText = source.line(diagnostic.line);
+        switch (diagnostic.code) {
+            case UNKNOWN_INSTRUCTION:
+            case MISSING_PARSING_METHOD:
+            case EXCESS_TOKENS:
+            case MISSING_CONJUNCTION:
+            case UNKNOWN_CONJUNCTION:
+            case MISSING_CONDITION:
+            case UNKNOWN_CONDITION:
+            case MISSING_OPERAND:
+            case UNKNOWN_OPERAND:
+            case MISSING_DESCRIPTOR:
+            case UNKNOWN_DESCRIPTOR:
+                writer << "\nInvalid syntax at line " << lineNumber << ": " << lineText << '\n';
+                break;
+            case DUPLICATE_LABEL:
+            case UNDEFINED_LABEL:
+                writer << "\nLabel error at line " << lineNumber << ": " << lineText << '\n';
+                break;
+            case REGISTER_SCOPE:
+            case MEMORY_SCOPE:
+            case INSTRUCTION_SCOPE:
+            case INSTRUCTION_LIMIT:
+                writer << "\nScope error at line " << lineNumber << ": " << lineText << '\n';
+                break;
+            case UNRECOGNIZED_OPERAND:
+            case EXTRA_OPERAND:
+                //One heading for all the operands of an instruction
+                if (previous == nullptr || !isSemantic(previous->code) || previous->line != diagnostic.line) {
+                    writer << "Invalid syntax at line " << lineNumber << ": " << lineText << '\n';
+                }
+                break;
+        }
+        switch (diagnostic.code) {
+            case UNKNOWN_INSTRUCTION:
+                writer << "Unknown instruction '" << diagnostic.token << "'\n";
+                break;
+            case MISSING_PARSING_METHOD:
+                writer << "Compiler error for '" << diagnostic.token << "'. Could not find instruction parsing method.\n";
+                break;
+            case EXCESS_TOKENS:
+                writer << "Excess tokens at and past '" << diagnostic.token << "' found.\n";
+                break;
+            case MISSING_CONJUNCTION:
+                writer << "Missing conjunction. Expected '" << diagnostic.detail << "'\n";
+                break;
+            case UNKNOWN_CONJUNCTION:
+                writer << "Unknown conjunction '" << diagnostic.token << "'. Expected '" << diagnostic.detail << "'\n";
+                break;
+            case MISSING_CONDITION:
+                writer << "Missing condition. Expected '" << diagnostic.detail << "'\n";
+                break;
+            case UNKNOWN_CONDITION:
+                writer << "Unknown condition '" << diagnostic.token << "'. Expected '" << diagnostic.detail << "'\n";
+                break;
+            case MISSING_OPERAND:
+                writer << "Missing operand after '" << diagnostic.detail << "'\n";
+                break;
+            case UNKNOWN_OPERAND:
+                writer << "Unknown operand '" << diagnostic.token << "' after '" << diagnostic.detail << "'\n";
+                break;
+            case MISSING_DESCRIPTOR:
+                writer << "Missing descriptor after '" << diagnostic.detail << "'\n";
+                break;
+            case UNKNOWN_DESCRIPTOR:
+                writer << "Unknown descriptor '" << diagnostic.token << "' after '" << diagnostic.detail << "'\n";
+                break;
+            case DUPLICATE_LABEL:
+                writer << "Duplicate label " << diagnostic.token << " already declared at line " << static_cast<size_t>(diagnostic.declaredLine) + 1 << '\n';
+                break;
+            case UNDEFINED_LABEL:
+                writer << "Undefined label " << diagnostic.token << '\n';
+                break;
+            case REGISTER_SCOPE:
+                writer << "Register '";
+                writer.operand(diagnostic);
+                writer << "' is out of range. Max register is r9\n";
+                break;
+            case MEMORY_SCOPE:
+                writer << "Memory address '";
+                writer.operand(diagnostic);
+                writer << "' is out of range. Max address is m<999999999>\n";
+                break;
+            case INSTRUCTION_SCOPE:
+                writer << "Instruction address '";
+                writer.operand(diagnostic);
+                writer << "' is out of range. Expected i[0]-i[" << source.numLines() << "]\n";
+                break;
+            case INSTRUCTION_LIMIT:
+                writer << "Instruction address '";
+                writer.operand(diagnostic);
+                writer << "' is out of range. Max address is i[999999999]\n";
+                break;
+            case UNRECOGNIZED_OPERAND:
+                writer << "Unrecognized operand '";
+                writer.operand(diagnostic);
+                writer << "'. Expected " << diagnostic.detail << "\n\n";
+                break;
+            case EXTRA_OPERAND:
+                writer << "Unexpected extra operand '";
+                writer.operand(diagnostic);
+                writer << "'\n\n";
+                break;
+        }
+        previous = &diagnostic;
+    }
+    //Later diagnostics (and stages) were skipped once the limit was reached
+    if (full()) {
+        writer << "\nStopped after " << m_maxErrors << (m_maxErrors == 1 ? " error" : " errors") << " (--max-errors)\n";
+    }
+    return report;
+}
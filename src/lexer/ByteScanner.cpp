@@ -0,0 +1,203 @@
+#include "lexer/ByteScanner.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define STARTASM_X86_SCANNER 1
+#endif
+
+using namespace std;
+using namespace ByteScannerConstants;
+
+namespace {
+    constexpr size_t BLOCK_SIZE = 64;
+
+    //Whitespace as defined by isspace in the C locale
+    inline bool isWhitespace(unsigned char c) {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    //Portable scalar mask builders
+    uint64_t newlineMaskScalar(const char* block) {
+        uint64_t mask = 0;
+        for (size_t i = 0; i < BLOCK_SIZE; i++) {
+            mask |= static_cast<uint64_t>(block[i] == '\n') << i;
+        }
+        return mask;
+    }
+
+    uint64_t whitespaceMaskScalar(const char* block) {
+        uint64_t mask = 0;
+        for (size_t i = 0; i < BLOCK_SIZE; i++) {
+            mask |= static_cast<uint64_t>(isWhitespace(static_cast<unsigned char>(block[i]))) << i;
+        }
+        return mask;
+    }
+
+#ifdef STARTASM_X86_SCANNER
+    //SSE4.2 mask builders - 16 bytes per step, whitespace matched as a character set with PCMPESTRM
+    __attribute__((target("sse4.2")))
+    uint64_t newlineMaskSSE42(const char* block) {
+        const __m128i newline = _mm_set1_epi8('\n');
+        uint64_t mask = 0;
+        for (size_t i = 0; i < BLOCK_SIZE; i += 16) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+            mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline)))) << i;
+        }
+        return mask;
+    }
+
+    __attribute__((target("sse4.2")))
+    uint64_t whitespaceMaskSSE42(const char* block) {
+        const __m128i whitespace = _mm_setr_epi8(' ', '\t', '\n', '\v', '\f', '\r', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        uint64_t mask = 0;
+        for (size_t i = 0; i < BLOCK_SIZE; i += 16) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+            __m128i matches = _mm_cmpestrm(whitespace, 6, bytes, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK);
+            mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_cvtsi128_si32(matches))) << i;
+        }
+        return mask;
+    }
+
+    //AVX2 mask builders - 32 bytes per step, whitespace matched as ' ' or the '\t'-'\r' range
+    __attribute__((target("avx2")))
+    uint64_t newlineMaskAVX2(const char* block) {
+        const __m256i newline = _mm256_set1_epi8('\n');
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+        __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+        uint64_t lowMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, newline)));
+        uint64_t highMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, newline)));
+        return lowMask | (highMask << 32);
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256i whitespaceAVX2(__m256i bytes) {
+        const __m256i space = _mm256_set1_epi8(' ');
+        const __m256i tab = _mm256_set1_epi8('\t');
+        const __m256i rangeWidth = _mm256_set1_epi8('\r' - '\t');
+        //Bytes in ['\t', '\r'] are those where (byte - '\t') is unchanged by an unsigned min with the range width
+        __m256i offset = _mm256_sub_epi8(bytes, tab);
+        __m256i inRange = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, rangeWidth), offset);
+        return _mm256_or_si256(inRange, _mm256_cmpeq_epi8(bytes, space));
+    }
+
+    __attribute__((target("avx2")))
+    uint64_t whitespaceMaskAVX2(const char* block) {
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+        __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+        uint64_t lowMask = static_cast<uint32_t>(_mm256_movemask_epi8(whitespaceAVX2(low)));
+        uint64_t highMask = static_cast<uint32_t>(_mm256_movemask_epi8(whitespaceAVX2(high)));
+        return lowMask | (highMask << 32);
+    }
+#endif
+
+    //Index of the lowest set bit (mask must be non-zero)
+    inline unsigned lowestBit(uint64_t mask) {
+        return static_cast<unsigned>(__builtin_ctzll(mask));
+    }
+}
+
+const ByteScanner::MaskFunctions& ByteScanner::getMaskFunctions() {
+    //Selected once, on first use
+    static const MaskFunctions functions = [] {
+#ifdef STARTASM_X86_SCANNER
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return MaskFunctions{AVX2, newlineMaskAVX2, whitespaceMaskAVX2};
+        }
+        if (__builtin_cpu_supports("sse4.2")) {
+            return MaskFunctions{SSE42, newlineMaskSSE42, whitespaceMaskSSE42};
+        }
+#endif
+        return MaskFunctions{SCALAR, newlineMaskScalar, whitespaceMaskScalar};
+    }();
+    return functions;
+}
+
+ScannerLevel ByteScanner::getLevel() {
+    return getMaskFunctions().level;
+}
+
+const char* ByteScanner::getLevelName() {
+    switch (getLevel()) {
+        case AVX2:
+            return "AVX2";
+        case SSE42:
+            return "SSE4.2";
+        default:
+            return "scalar";
+    }
+}
+
+void ByteScanner::indexLines(const char* data, size_t size, vector<string_view>& lines) {
+    MaskFunction newlineMask = getMaskFunctions().newlineMask;
+    size_t lineStart = 0;
+    size_t offset = 0;
+    //Full blocks are read in place. The tail is copied into a padded block so nothing past the buffer is read
+    while (offset < size) {
+        uint64_t mask;
+        if (size - offset >= BLOCK_SIZE) {
+            mask = newlineMask(data + offset);
+        }
+        else {
+            char tail[BLOCK_SIZE] = {};
+            memcpy(tail, data + offset, size - offset);
+            mask = newlineMask(tail);
+        }
+        //Every set bit ends a line
+        while (mask != 0) {
+            size_t lineEnd = offset + lowestBit(mask);
+            lines.emplace_back(data + lineStart, lineEnd - lineStart);
+            lineStart = lineEnd + 1;
+            mask &= mask - 1;
+        }
+        offset += BLOCK_SIZE;
+    }
+    //Final line without a trailing newline
+    if (lineStart < size) {
+        lines.emplace_back(data + lineStart, size - lineStart);
+    }
+}
+
+void ByteScanner::splitTokens(string_view line, vector<string_view>& tokens) {
+    MaskFunction whitespaceMask = getMaskFunctions().whitespaceMask;
+    tokens.clear();
+    const char* data = line.data();
+    size_t size = line.size();
+    size_t tokenStart = 0;
+    //Whether the byte before the current block was part of a token
+    uint64_t carry = 0;
+    for (size_t offset = 0; offset < size; offset += BLOCK_SIZE) {
+        uint64_t whitespace;
+        if (size - offset >= BLOCK_SIZE) {
+            whitespace = whitespaceMask(data + offset);
+        }
+        else {
+            char tail[BLOCK_SIZE];
+            memset(tail, ' ', BLOCK_SIZE);
+            memcpy(tail, data + offset, size - offset);
+            whitespace = whitespaceMask(tail);
+        }
+        //Tokens start where a non-whitespace byte follows whitespace, and end at the reverse transition
+        uint64_t inToken = ~whitespace;
+        uint64_t previous = (inToken << 1) | carry;
+        uint64_t boundaries = (inToken & ~previous) | (~inToken & previous);
+        carry = inToken >> 63;
+        //Boundaries alternate between token starts and ends
+        while (boundaries != 0) {
+            size_t position = offset + lowestBit(boundaries);
+            if ((inToken >> (position - offset)) & 1) {
+                tokenStart = position;
+            }
+            else {
+                tokens.emplace_back(data + tokenStart, position - tokenStart);
+            }
+            boundaries &= boundaries - 1;
+        }
+    }
+    //Token running to the end of the line
+    if (carry != 0) {
+        tokens.emplace_back(data + tokenStart, size - tokenStart);
+    }
+}
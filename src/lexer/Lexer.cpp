@@ -1,70 +1,175 @@
 #include "lexer/Lexer.h"
+#include "lexer/ByteScanner.h"
+#include "lang/Keywords.h"
 
-#include <fstream>
 #include <regex>
 #include <string>
 #include <functional>
 #include <utility>
-#include <sstream>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <charconv>
+#include <system_error>
+#include <future>
+#include <unordered_map>
+#include <omp.h>
 
 using namespace std;
 using namespace LexerConstants;
 
+//Operand DFA - a hand-written equivalent of the regex operand dictionary, evaluated in one pass over the bytes
+namespace {
+    //Character classes the DFA distinguishes between
+    enum CharClass : uint8_t {C_ZERO, C_DIGIT, C_R, C_M, C_I, C_LT, C_GT, C_LBRACKET, C_RBRACKET, C_MINUS, C_DOT, C_QUOTE, C_T, C_U, C_E, C_F, C_A, C_L, C_S, C_OTHER, NUM_CLASSES};
+
+    //DFA states. INT_1 to INT_10 count the digits of a decimal integer (the regex allows at most 10)
+    enum State : uint8_t {
+        S_START, S_DEAD,
+        S_R, S_R_DIGITS,
+        S_M, S_M_OPEN, S_M_DIGITS, S_M_CLOSE,
+        S_I, S_I_OPEN, S_I_DIGITS, S_I_CLOSE,
+        S_MINUS, S_ZERO,
+        S_INT_1, S_INT_2, S_INT_3, S_INT_4, S_INT_5, S_INT_6, S_INT_7, S_INT_8, S_INT_9, S_INT_10,
+        S_FLOAT_WHOLE, S_FLOAT_DOT, S_FLOAT_FRACTION,
+        S_T, S_TR, S_TRU, S_TRUE,
+        S_F, S_FA, S_FAL, S_FALS, S_FALSE,
+        S_LABEL_OPEN, S_LABEL_BODY, S_LABEL_CLOSE,
+        NUM_STATES
+    };
+
+    using TransitionTable = array<array<uint8_t, NUM_CLASSES>, NUM_STATES>;
+
+    constexpr array<uint8_t, 256> buildCharClasses() {
+        array<uint8_t, 256> classes{};
+        for (int c = 0; c < 256; c++) {
+            classes[c] = C_OTHER;
+        }
+        for (int c = '1'; c <= '9'; c++) {
+            classes[c] = C_DIGIT;
+        }
+        classes['0'] = C_ZERO;
+        classes['r'] = C_R;
+        classes['m'] = C_M;
+        classes['i'] = C_I;
+        classes['<'] = C_LT;
+        classes['>'] = C_GT;
+        classes['['] = C_LBRACKET;
+        classes[']'] = C_RBRACKET;
+        classes['-'] = C_MINUS;
+        classes['.'] = C_DOT;
+        classes['\''] = C_QUOTE;
+        classes['t'] = C_T;
+        classes['u'] = C_U;
+        classes['e'] = C_E;
+        classes['f'] = C_F;
+        classes['a'] = C_A;
+        classes['l'] = C_L;
+        classes['s'] = C_S;
+        return classes;
+    }
+
+    constexpr TransitionTable buildTransitions() {
+        TransitionTable table{};
+        //Every transition not listed below goes to the dead state
+        for (int s = 0; s < NUM_STATES; s++) {
+            for (int c = 0; c < NUM_CLASSES; c++) {
+                table[s][c] = S_DEAD;
+            }
+        }
+        //Registers - r[0-9]+
+        table[S_START][C_R] = S_R;
+        table[S_R][C_ZERO] = table[S_R][C_DIGIT] = S_R_DIGITS;
+        table[S_R_DIGITS][C_ZERO] = table[S_R_DIGITS][C_DIGIT] = S_R_DIGITS;
+        //Memory addresses - m<[0-9]+>
+        table[S_START][C_M] = S_M;
+        table[S_M][C_LT] = S_M_OPEN;
+        table[S_M_OPEN][C_ZERO] = table[S_M_OPEN][C_DIGIT] = S_M_DIGITS;
+        table[S_M_DIGITS][C_ZERO] = table[S_M_DIGITS][C_DIGIT] = S_M_DIGITS;
+        table[S_M_DIGITS][C_GT] = S_M_CLOSE;
+        //Instruction addresses - i\[[0-9]+\]
+        table[S_START][C_I] = S_I;
+        table[S_I][C_LBRACKET] = S_I_OPEN;
+        table[S_I_OPEN][C_ZERO] = table[S_I_OPEN][C_DIGIT] = S_I_DIGITS;
+        table[S_I_DIGITS][C_ZERO] = table[S_I_DIGITS][C_DIGIT] = S_I_DIGITS;
+        table[S_I_DIGITS][C_RBRACKET] = S_I_CLOSE;
+        //Integers - -?[1-9][0-9]{0,9}|0, falling back to the whole part of a float past 10 digits
+        table[S_START][C_MINUS] = S_MINUS;
+        table[S_START][C_ZERO] = S_ZERO;
+        table[S_START][C_DIGIT] = S_INT_1;
+        table[S_MINUS][C_DIGIT] = S_INT_1;
+        table[S_MINUS][C_ZERO] = S_FLOAT_WHOLE;
+        table[S_ZERO][C_ZERO] = table[S_ZERO][C_DIGIT] = S_FLOAT_WHOLE;
+        table[S_ZERO][C_DOT] = S_FLOAT_DOT;
+        for (int s = S_INT_1; s < S_INT_10; s++) {
+            table[s][C_ZERO] = table[s][C_DIGIT] = static_cast<uint8_t>(s + 1);
+            table[s][C_DOT] = S_FLOAT_DOT;
+        }
+        table[S_INT_10][C_ZERO] = table[S_INT_10][C_DIGIT] = S_FLOAT_WHOLE;
+        table[S_INT_10][C_DOT] = S_FLOAT_DOT;
+        //Floats - -?\d+\.\d+
+        table[S_FLOAT_WHOLE][C_ZERO] = table[S_FLOAT_WHOLE][C_DIGIT] = S_FLOAT_WHOLE;
+        table[S_FLOAT_WHOLE][C_DOT] = S_FLOAT_DOT;
+        table[S_FLOAT_DOT][C_ZERO] = table[S_FLOAT_DOT][C_DIGIT] = S_FLOAT_FRACTION;
+        table[S_FLOAT_FRACTION][C_ZERO] = table[S_FLOAT_FRACTION][C_DIGIT] = S_FLOAT_FRACTION;
+        //Booleans - true|false (1 and 0 are always claimed by the integer pattern first)
+        table[S_START][C_T] = S_T;
+        table[S_T][C_R] = S_TR;
+        table[S_TR][C_U] = S_TRU;
+        table[S_TRU][C_E] = S_TRUE;
+        table[S_START][C_F] = S_F;
+        table[S_F][C_A] = S_FA;
+        table[S_FA][C_L] = S_FAL;
+        table[S_FAL][C_S] = S_FALS;
+        table[S_FALS][C_E] = S_FALSE;
+        //Labels - '([^']+)'
+        table[S_START][C_QUOTE] = S_LABEL_OPEN;
+        for (int c = 0; c < NUM_CLASSES; c++) {
+            if (c != C_QUOTE) {
+                table[S_LABEL_OPEN][c] = S_LABEL_BODY;
+                table[S_LABEL_BODY][c] = S_LABEL_BODY;
+            }
+        }
+        table[S_LABEL_BODY][C_QUOTE] = S_LABEL_CLOSE;
+        return table;
+    }
+
+    constexpr array<TokenType, NUM_STATES> buildAcceptingTypes() {
+        array<TokenType, NUM_STATES> accepting{};
+        for (int s = 0; s < NUM_STATES; s++) {
+            accepting[s] = UNKNOWN;
+        }
+        accepting[S_R_DIGITS] = REGISTER;
+        accepting[S_M_CLOSE] = MEMORYADDRESS;
+        accepting[S_I_CLOSE] = INSTRUCTIONADDRESS;
+        accepting[S_ZERO] = INTEGER;
+        for (int s = S_INT_1; s <= S_INT_10; s++) {
+            accepting[s] = INTEGER;
+        }
+        accepting[S_FLOAT_FRACTION] = FLOAT;
+        accepting[S_TRUE] = BOOLEAN;
+        accepting[S_FALSE] = BOOLEAN;
+        accepting[S_LABEL_CLOSE] = LABEL;
+        return accepting;
+    }
+
+    constexpr array<uint8_t, 256> kCharClasses = buildCharClasses();
+    constexpr TransitionTable kTransitions = buildTransitions();
+    constexpr array<TokenType, NUM_STATES> kAcceptingTypes = buildAcceptingTypes();
+}
+
 //Constructor
-Lexer::Lexer() : m_stringTemplate("^\".*\"$") {
-    //Reserve space for the token dictionary
-    m_tokenDictionary.reserve(39); //Total number of tokens being added
-
-    //Add instructions to dictionary
-    m_tokenDictionary["move"] = INSTRUCTION;
-    m_tokenDictionary["load"] = INSTRUCTION;
-    m_tokenDictionary["store"] = INSTRUCTION;
-    m_tokenDictionary["create"] = INSTRUCTION;
-    m_tokenDictionary["cast"] = INSTRUCTION;
-    m_tokenDictionary["add"] = INSTRUCTION;
-    m_tokenDictionary["sub"] = INSTRUCTION;
-    m_tokenDictionary["multiply"] = INSTRUCTION;
-    m_tokenDictionary["divide"] = INSTRUCTION;
-    m_tokenDictionary["or"] = INSTRUCTION;
-    m_tokenDictionary["and"] = INSTRUCTION;
-    m_tokenDictionary["not"] = INSTRUCTION;
-    m_tokenDictionary["shift"] = INSTRUCTION;
-    m_tokenDictionary["compare"] = INSTRUCTION;
-    m_tokenDictionary["jump"] = INSTRUCTION;
-    m_tokenDictionary["call"] = INSTRUCTION;
-    m_tokenDictionary["push"] = INSTRUCTION;
-    m_tokenDictionary["pop"] = INSTRUCTION;
-    m_tokenDictionary["return"] = INSTRUCTION;
-    m_tokenDictionary["stop"] = INSTRUCTION;
-    m_tokenDictionary["input"] = INSTRUCTION;
-    m_tokenDictionary["output"] = INSTRUCTION;
-    m_tokenDictionary["print"] = INSTRUCTION;
-    m_tokenDictionary["label"] = INSTRUCTION;
-
-    //Add conjunctions to dictionary
-    m_tokenDictionary["from"] = CONJUNCTION;
-    m_tokenDictionary["with"] = CONJUNCTION;
-    m_tokenDictionary["self"] = CONJUNCTION;
-    m_tokenDictionary["to"] = CONJUNCTION;
-    m_tokenDictionary["by"] = CONJUNCTION;
-    m_tokenDictionary["if"] = CONJUNCTION;
-
-    //Add conditions to dictionary
-    m_tokenDictionary["left"] = SHIFTCONDITION;
-    m_tokenDictionary["right"] = SHIFTCONDITION;
-    m_tokenDictionary["greater"] = JUMPCONDITION;
-    m_tokenDictionary["less"] = JUMPCONDITION;
-    m_tokenDictionary["equal"] = JUMPCONDITION;
-    m_tokenDictionary["unequal"] = JUMPCONDITION;
-    m_tokenDictionary["zero"] = JUMPCONDITION;
-    m_tokenDictionary["nonzero"] = JUMPCONDITION;
-    m_tokenDictionary["unconditional"] = JUMPCONDITION;
-    m_tokenDictionary["integer"] = TYPECONDITION;
-    m_tokenDictionary["float"] = TYPECONDITION;
-    m_tokenDictionary["boolean"] = TYPECONDITION;
-    m_tokenDictionary["character"] = TYPECONDITION;
-    m_tokenDictionary["memory"] = TYPECONDITION;
-    m_tokenDictionary["instruction"] = TYPECONDITION;
+Lexer::Lexer(ClassifierMode classifierMode) : m_classifierMode(classifierMode) {
+    //Keywords are looked up in the compile-time table (lang/Keywords.h), so only operand templates are built here
+    //The DFA classifier needs no regex templates, so only build them in regex mode
+    if (m_classifierMode != REGEX) {
+        return;
+    }
+
+    //Compile the string template
+    m_stringTemplate = regex("^\".*\"$");
 
     //Reserve space for the operand dictionary
     m_operandDictionary.reserve(8); //Total number of regex templates being added
@@ -82,120 +187,349 @@ Lexer::Lexer() : m_stringTemplate("^\".*\"$") {
 
 
 //Main lexer method
-bool Lexer::lexFile(const std::string& filename, std::vector<std::string>& codeLines, std::vector<std::vector<std::pair<std::string, LexerConstants::TokenType>>>& tokenizedCode) {
-    //Read the file
-    if (!readFile(filename, codeLines)) {
-        return false;
-    }
-    //Tokenize the file
-    tokenizeFile(codeLines, tokenizedCode);
-    return true;
+namespace {
+    //Bytes read ahead and lexed at a time by the file pipeline
+    constexpr size_t CHUNK_SIZE = size_t(4) << 20;
+    //Label hash shards interned independently
+    constexpr size_t NUM_SYMBOL_SHARDS = 64;
 }
 
-//Read file method
-bool Lexer::readFile(const string& filename, vector<string>& codeLines) {
-    //Create a file stream and open the file
-    ifstream file(filename);
-    //If file is not open, return false
-    if (!file.is_open()) {
+bool Lexer::lexFile(const std::string& filename, SourceManager& sourceManager, TokenStream& tokenizedCode) {
+    //Map the file into memory. If it can't be opened, return false
+    if (!sourceManager.open(filename)) {
         return false;
     }
-    //Temporary string to hold the line
-    string line;
-    //Loop through every line in the file
-    while (getline(file, line)) {
-        //Push back the line into the vector
-        codeLines.push_back(line);
+    const SourceBuffer& source = sourceManager.m_buffer;
+    vector<string_view>& codeLines = sourceManager.m_lines;
+    tokenizedCode.m_lines = &codeLines;
+    tokenizedCode.m_tokens.clear();
+    tokenizedCode.m_lineStarts.assign(1, 0);
+    tokenizedCode.m_symbols.clear();
+
+    //Pipeline over newline aligned chunks. While the workers lex one chunk, the next is paged in in the background,
+    //so reading the file overlaps with lexing it
+    size_t chunkBegin = 0;
+    size_t chunkEnd = source.chunkEnd(0, CHUNK_SIZE);
+    while (chunkBegin < source.size()) {
+        size_t nextEnd = source.chunkEnd(chunkEnd, CHUNK_SIZE);
+        //Start kernel readahead for the chunk after next, and fault in the next chunk
+        source.prefetch(nextEnd, CHUNK_SIZE);
+        future<void> reader;
+        if (chunkEnd < nextEnd) {
+            reader = async(launch::async, [&source, chunkEnd, nextEnd] {
+                source.load(chunkEnd, nextEnd - chunkEnd);
+            });
+        }
+        //Lex the current chunk
+        lexChunk(source.data() + chunkBegin, chunkEnd - chunkBegin, codeLines, tokenizedCode);
+        //Move on once the next chunk is in memory
+        if (reader.valid()) {
+            reader.get();
+        }
+        chunkBegin = chunkEnd;
+        chunkEnd = nextEnd;
     }
-    //Close the file
-    file.close();
-    //Return true
+    //Every label is known now - give each distinct one its ID
+    internLabels(tokenizedCode);
     return true;
 }
 
-//Tokenize file method
-void Lexer::tokenizeFile(vector<string>& codeLines, vector<vector<pair<string, TokenType>>>& tokenizedCode) {
-    //Preallocate depending on the number of lines to allow sequential write
-    std::vector<std::vector<std::pair<string, LexerConstants::TokenType>>> tempTokens(codeLines.size());
+void Lexer::lexChunk(const char* data, size_t size, vector<string_view>& codeLines, TokenStream& tokenizedCode) {
+    size_t firstLine = codeLines.size();
+    size_t firstToken = tokenizedCode.m_tokens.size();
+    //Lines and tokens each thread produced, turned into where its lines and tokens start in the stream
+    vector<size_t> lineOffsets;
+    vector<size_t> tokenOffsets;
 
-    // Parallelize lexing of each line
-    #pragma omp parallel for schedule(auto) default(none) shared(codeLines, tempTokens)
-    for (long unsigned int i = 0; i < codeLines.size(); i++) {
-        // Each thread works on its own part of the vector
-        tempTokens[i] = tokenizeLine(codeLines[i]);
-    }
+    //Each thread takes an equal byte range, starting at the first line that begins inside it. It indexes and
+    //tokenizes those lines into its own buffers, then copies them into place once every thread's size is known
+    #pragma omp parallel default(none) shared(data, size, codeLines, tokenizedCode, lineOffsets, tokenOffsets, firstLine, firstToken)
+    {
+        #pragma omp single
+        {
+            lineOffsets.assign(omp_get_num_threads() + 1, 0);
+            tokenOffsets.assign(omp_get_num_threads() + 1, 0);
+        }
 
-    // Flatten the results into m_codeTokens
-    for (const auto& lineTokens : tempTokens) {
-        tokenizedCode.push_back(lineTokens);
+        size_t thread = omp_get_thread_num();
+        size_t numThreads = lineOffsets.size() - 1;
+        //A line belongs to the range its first byte is in
+        auto lineBoundary = [data, size](size_t position) {
+            if (position == 0 || position >= size) {
+                return min(position, size);
+            }
+            const void* newline = memchr(data + position - 1, '\n', size - position + 1);
+            return newline == nullptr ? size : static_cast<size_t>(static_cast<const char*>(newline) - data) + 1;
+        };
+        size_t begin = lineBoundary(size * thread / numThreads);
+        size_t end = lineBoundary(size * (thread + 1) / numThreads);
+
+        vector<string_view> threadLines;
+        ByteScanner::indexLines(data + begin, end - begin, threadLines);
+        //Line starts are counted per thread first and offset once the thread's position is known
+        vector<uint32_t> threadLineStarts;
+        threadLineStarts.reserve(threadLines.size());
+        vector<TokenStream::Token> threadTokens;
+        threadTokens.reserve(threadLines.size() * 6);
+        for (string_view line : threadLines) {
+            tokenizeLine(line, threadTokens);
+            threadLineStarts.push_back(static_cast<uint32_t>(threadTokens.size()));
+        }
+        lineOffsets[thread + 1] = threadLines.size();
+        tokenOffsets[thread + 1] = threadTokens.size();
+
+        //Prefix sum the thread counts into offsets and grow the line index and stream once
+        #pragma omp barrier
+        #pragma omp single
+        {
+            lineOffsets[0] = firstLine;
+            tokenOffsets[0] = firstToken;
+            for (size_t t = 0; t < numThreads; t++) {
+                lineOffsets[t + 1] += lineOffsets[t];
+                tokenOffsets[t + 1] += tokenOffsets[t];
+            }
+            codeLines.resize(lineOffsets[numThreads]);
+            tokenizedCode.m_lineStarts.resize(lineOffsets[numThreads] + 1);
+            tokenizedCode.m_tokens.resize(tokenOffsets[numThreads]);
+        }
+
+        size_t lineOffset = lineOffsets[thread];
+        size_t tokenOffset = tokenOffsets[thread];
+        copy(threadLines.begin(), threadLines.end(), codeLines.begin() + static_cast<ptrdiff_t>(lineOffset));
+        copy(threadTokens.begin(), threadTokens.end(), tokenizedCode.m_tokens.begin() + static_cast<ptrdiff_t>(tokenOffset));
+        for (size_t i = 0; i < threadLineStarts.size(); i++) {
+            tokenizedCode.m_lineStarts[lineOffset + i + 1] = threadLineStarts[i] + static_cast<uint32_t>(tokenOffset);
+        }
     }
 }
 
-//Tokenize line helper function
-vector<pair<string, TokenType>> Lexer::tokenizeLine(string& line) {
-    //Create a string stream for the line, a temporary token string, and the return vector
-    stringstream ss(line);
-    string token;
-    vector<pair<string, TokenType>> tokenizedLine;
+void Lexer::internLabels(TokenStream& tokenizedCode) {
+    //A label token waiting for its ID
+    struct LabelToken {
+        size_t index;
+        string_view text;
+    };
+    int numLines = static_cast<int>(tokenizedCode.numLines());
+    const vector<TokenStream::Token>& tokens = tokenizedCode.m_tokens;
+    const vector<uint32_t>& lineStarts = tokenizedCode.m_lineStarts;
+    const vector<string_view>& lines = *tokenizedCode.m_lines;
 
-    //Zero case, return instantly
-    if (line.empty()) {
-        tokenizedLine.emplace_back("", BLANK);
-        return tokenizedLine;
+    //Each thread splits the label tokens of its contiguous block of lines by hash shard, so taken in thread order
+    //every shard list is in line order
+    vector<vector<vector<LabelToken>>> threadShards(omp_get_max_threads(), vector<vector<LabelToken>>(NUM_SYMBOL_SHARDS));
+    #pragma omp parallel for schedule(static) default(none) shared(numLines, tokens, lineStarts, lines, threadShards)
+    for (int i=0; i<numLines; i++) {
+        for (size_t j=lineStarts[i]; j<lineStarts[i+1]; j++) {
+            if (tokens[j].type == LABEL) {
+                string_view text = lines[i].substr(tokens[j].offset, tokens[j].length);
+                threadShards[omp_get_thread_num()][hash<string_view>{}(text) % NUM_SYMBOL_SHARDS].push_back({j, text});
+            }
+        }
     }
 
+    //Number the distinct labels of every shard in order of first use, independently of the other shards
+    int numThreads = static_cast<int>(threadShards.size());
+    vector<vector<string_view>> shardSymbols(NUM_SYMBOL_SHARDS);
+    #pragma omp parallel for schedule(dynamic) default(none) shared(numThreads, threadShards, shardSymbols, tokenizedCode)
+    for (size_t shard=0; shard<NUM_SYMBOL_SHARDS; shard++) {
+        unordered_map<string_view, uint32_t> ids;
+        for (int thread=0; thread<numThreads; thread++) {
+            for (const LabelToken& label : threadShards[thread][shard]) {
+                auto [itr, inserted] = ids.try_emplace(label.text, static_cast<uint32_t>(shardSymbols[shard].size()));
+                if (inserted) {
+                    shardSymbols[shard].push_back(label.text);
+                }
+                tokenizedCode.m_tokens[label.index].payload.symbol = itr->second;
+            }
+        }
+    }
+
+    //Lay the shards out one after another - a label's ID is its shard's offset plus its number in the shard. The IDs
+    //only depend on the source, not on the number of threads
+    vector<uint32_t> shardOffsets(NUM_SYMBOL_SHARDS + 1, 0);
+    for (size_t shard=0; shard<NUM_SYMBOL_SHARDS; shard++) {
+        shardOffsets[shard+1] = shardOffsets[shard] + static_cast<uint32_t>(shardSymbols[shard].size());
+    }
+    tokenizedCode.m_symbols.resize(shardOffsets[NUM_SYMBOL_SHARDS]);
+    #pragma omp parallel for schedule(dynamic) default(none) shared(numThreads, threadShards, shardSymbols, shardOffsets, tokenizedCode)
+    for (size_t shard=0; shard<NUM_SYMBOL_SHARDS; shard++) {
+        copy(shardSymbols[shard].begin(), shardSymbols[shard].end(), tokenizedCode.m_symbols.begin() + shardOffsets[shard]);
+        for (int thread=0; thread<numThreads; thread++) {
+            for (const LabelToken& label : threadShards[thread][shard]) {
+                tokenizedCode.m_tokens[label.index].payload.symbol += shardOffsets[shard];
+            }
+        }
+    }
+}
+
+void Lexer::tokenizeLine(string_view line, vector<TokenStream::Token>& tokenizedLine) {
+    //Split the line into whitespace separated tokens in bulk
+    static thread_local vector<string_view> lineTokens;
+    ByteScanner::splitTokens(line, lineTokens);
+    //Records store the token position relative to the line
+    size_t firstToken = tokenizedLine.size();
+    auto emplaceToken = [&tokenizedLine, line](string_view token, TokenType type) {
+        OperandValue value = decodeOperand(token, type);
+        tokenizedLine.push_back({static_cast<uint32_t>(token.data() - line.data()), static_cast<uint32_t>(token.size()), value.payload, type, value.overflow});
+    };
+
     //Loop through every token
-    while (ss >> token) {
+    for (string_view token : lineTokens) {
         //Special case for comments and prints. These are the only instructions not separating operands by whitespace alone
-        if (token == "comment" || token == "print") {
+        const Keywords::Keyword* keyword = Keywords::lookup(token);
+        if (keyword != nullptr && (keyword->instructionType == ASTConstants::COMMENT || keyword->instructionType == ASTConstants::PRINT)) {
             //Push back string as an instruction
-            tokenizedLine.emplace_back(token, INSTRUCTION);
-            //Temporary string to hold the comment and a regex template to check for validity
-            string operandString;
-            //Get rest of the line
-            getline(ss, operandString);
-            operandString.erase(0, 1);
+            emplaceToken(token, INSTRUCTION);
+            //The operand is the rest of the line, minus the single separating character
+            string_view operandString = line.substr(static_cast<size_t>(token.data() - line.data()) + token.size());
+            if (!operandString.empty()) {
+                operandString.remove_prefix(1);
+            }
             //First we need to determine if the next token is a newline - special case
             if (operandString == "newline") {
-                tokenizedLine.emplace_back(operandString, NEWLINE);
+                emplaceToken(operandString, NEWLINE);
             }
-            //If matching regex template, denote string as "string"
-            else if (regex_match(operandString, m_stringTemplate)) {
-                tokenizedLine.emplace_back(operandString, STRING);
+            //If matching the string template, denote string as "string"
+            else if (isStringLiteral(operandString)) {
+                emplaceToken(operandString, STRING);
             }
             //Denote string unknown otherwise
             else {
-                tokenizedLine.emplace_back(operandString, UNKNOWN);
+                emplaceToken(operandString, UNKNOWN);
             }
-            //Return vector instantly
-            return tokenizedLine;
+            //Return instantly
+            return;
         }
         //Case for not comments and strings (everything else)
         else {
-            //Attempt to find the token in the dictionary
-            auto itr = m_tokenDictionary.find(token);
-            //If found in the token dictionary (instructions, conjunctions, descriptors, conditions) push it back
-            if (itr != m_tokenDictionary.end()) {
-                tokenizedLine.emplace_back(token, itr->second);
+            //If found in the keyword table (instructions, conjunctions, descriptors, conditions) push it back
+            if (keyword != nullptr) {
+                emplaceToken(token, keyword->tokenType);
+            }
+            //If not, check if it is an operand using the selected classifier
+            else if (m_classifierMode == REGEX) {
+                emplaceToken(token, classifyOperandRegex(token));
             }
-            //If not, check if it is an operand using regex
             else {
-                int i;
-                //Loop through vector of operand regex templates, checking every one
-                for (i=0; i<m_operandDictionary.size(); i++) {
-                    if (regex_match(token, m_operandDictionary[i].first)) {
-                        //If matching, push with corresponding operand type
-                        tokenizedLine.emplace_back(token, m_operandDictionary[i].second);
-                        break;
-                    }
-                }
-                if (i == m_operandDictionary.size()) {
-                    //If not either, push as unknown
-                    tokenizedLine.emplace_back(token, UNKNOWN);
-                }
+                emplaceToken(token, classifyOperandDFA(token));
             }
         }
     }
-    
-    return tokenizedLine;
-}
\ No newline at end of file
+
+    //Blank case - empty or whitespace-only lines
+    if (tokenizedLine.size() == firstToken) {
+        tokenizedLine.push_back({0, 0, OperandPayload{}, BLANK, false});
+    }
+}
+
+//Operand decoder - the classifier has already validated the digits, so only the range needs checking
+OperandValue Lexer::decodeOperand(string_view token, TokenType type) {
+    OperandValue value;
+    //Unsigned 32-bit number, flagging anything that doesn't fit
+    auto decodeAddress = [&value](string_view digits) {
+        from_chars_result result = from_chars(digits.data(), digits.data() + digits.size(), value.payload.address);
+        value.overflow = result.ec != errc();
+    };
+    switch (type) {
+        //r<index>
+        case REGISTER:
+            decodeAddress(token.substr(1));
+            break;
+        //m<address> and i[address]
+        case MEMORYADDRESS:
+        case INSTRUCTIONADDRESS:
+            decodeAddress(token.substr(2, token.size() - 3));
+            break;
+        case INTEGER: {
+            from_chars_result result = from_chars(token.data(), token.data() + token.size(), value.payload.integer);
+            value.overflow = result.ec != errc();
+            break;
+        }
+        case FLOAT: {
+            from_chars_result result = from_chars(token.data(), token.data() + token.size(), value.payload.real);
+            value.overflow = result.ec != errc();
+            break;
+        }
+        default:
+            break;
+    }
+    return value;
+}
+
+//String literal checker - equivalent to ^".*"$
+bool Lexer::isStringLiteral(string_view operandString) const {
+    if (m_classifierMode == REGEX) {
+        return regex_match(operandString.begin(), operandString.end(), m_stringTemplate);
+    }
+    //Must be wrapped in double quotes, and '.' does not match line terminators
+    if (operandString.size() < 2 || operandString.front() != '"' || operandString.back() != '"') {
+        return false;
+    }
+    return operandString.find_first_of("\r\n") == string::npos;
+}
+
+//Regex operand classifier (reference implementation)
+TokenType Lexer::classifyOperandRegex(string_view token) const {
+    //Loop through vector of operand regex templates, checking every one
+    for (const auto& operandTemplate : m_operandDictionary) {
+        if (regex_match(token.begin(), token.end(), operandTemplate.first)) {
+            //If matching, return the corresponding operand type
+            return operandTemplate.second;
+        }
+    }
+    //If not matching any template, the token is unknown
+    return UNKNOWN;
+}
+
+//Table-driven DFA operand classifier
+TokenType Lexer::classifyOperandDFA(string_view token) {
+    uint8_t state = S_START;
+    //Step through the transition table once per byte, stopping early once no pattern can match
+    for (unsigned char c : token) {
+        state = kTransitions[state][kCharClasses[c]];
+        if (state == S_DEAD) {
+            break;
+        }
+    }
+    TokenType type = kAcceptingTypes[state];
+    //Any other single character is a character literal (whitespace never reaches the classifier)
+    if (type == UNKNOWN && token.size() == 1) {
+        return CHARACTER;
+    }
+    return type;
+}
+
+//Token type names for printing
+string Lexer::tokenTypeToString(TokenType type) {
+    switch (type) {
+        case INSTRUCTION: return "INSTRUCTION";
+        case CONJUNCTION: return "CONJUNCTION";
+        case JUMPCONDITION: return "JUMPCONDITION";
+        case TYPECONDITION: return "TYPECONDITION";
+        case SHIFTCONDITION: return "SHIFTCONDITION";
+        case REGISTER: return "REGISTER";
+        case INSTRUCTIONADDRESS: return "INSTRUCTIONADDRESS";
+        case MEMORYADDRESS: return "MEMORYADDRESS";
+        case INTEGER: return "INTEGER";
+        case FLOAT: return "FLOAT";
+        case BOOLEAN: return "BOOLEAN";
+        case CHARACTER: return "CHARACTER";
+        case LABEL: return "LABEL";
+        case STRING: return "STRING";
+        case BLANK: return "BLANK";
+        case NEWLINE: return "NEWLINE";
+        default: return "UNKNOWN";
+    }
+}
+
+//Print every line's tokens with their types
+void Lexer::printTokens(const TokenStream& tokenizedCode) {
+    for (size_t i = 0; i < tokenizedCode.numLines(); i++) {
+        TokenStream::Line tokens = tokenizedCode.line(i);
+        cout << i + 1 << ":";
+        for (size_t j = 0; j < tokens.size(); j++) {
+            cout << " " << tokens.text(j) << "(" << tokenTypeToString(tokens.type(j)) << ")";
+        }
+        cout << "\n";
+    }
+}
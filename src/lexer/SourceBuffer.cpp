@@ -0,0 +1,82 @@
+#include "lexer/SourceBuffer.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+
+using namespace std;
+
+SourceBuffer::~SourceBuffer() {
+    close();
+}
+
+bool SourceBuffer::open(const string& filename) {
+    close();
+    //Open the file and get its size
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat fileStats{};
+    if (fstat(fd, &fileStats) != 0 || !S_ISREG(fileStats.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+    //Empty files can't be mapped, but are still valid (zero lines)
+    if (fileStats.st_size == 0) {
+        ::close(fd);
+        return true;
+    }
+    //Map the whole file read-only. The mapping stays valid after the descriptor is closed
+    void* mapping = mmap(nullptr, static_cast<size_t>(fileStats.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    //The lexer reads the file front to back
+    madvise(mapping, static_cast<size_t>(fileStats.st_size), MADV_SEQUENTIAL);
+    m_data = static_cast<const char*>(mapping);
+    m_size = static_cast<size_t>(fileStats.st_size);
+    return true;
+}
+
+void SourceBuffer::close() {
+    if (m_data != nullptr) {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+}
+
+size_t SourceBuffer::chunkEnd(size_t offset, size_t chunkSize) const {
+    if (offset >= m_size || m_size - offset <= chunkSize) {
+        return m_size;
+    }
+    //Extend the chunk to include the rest of the line it stops in
+    const char* newline = static_cast<const char*>(memchr(m_data + offset + chunkSize - 1, '\n', m_size - offset - chunkSize + 1));
+    return newline == nullptr ? m_size : static_cast<size_t>(newline - m_data) + 1;
+}
+
+void SourceBuffer::prefetch(size_t offset, size_t length) const {
+    if (offset >= m_size) {
+        return;
+    }
+    //madvise needs a page aligned start
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t alignedOffset = offset & ~(pageSize - 1);
+    size_t end = min(m_size, offset + length);
+    madvise(const_cast<char*>(m_data) + alignedOffset, end - alignedOffset, MADV_WILLNEED);
+}
+
+void SourceBuffer::load(size_t offset, size_t length) const {
+    //Touch one byte per page
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t end = min(m_size, offset + length);
+    volatile char sink = 0;
+    for (size_t position = offset; position < end; position += pageSize) {
+        sink = sink + m_data[position];
+    }
+}
@@ -0,0 +1,23 @@
+#include "lexer/SourceManager.h"
+
+#include <algorithm>
+
+using namespace std;
+
+bool SourceManager::open(const string& filename) {
+    m_lines.clear();
+    m_filename = filename;
+    return m_buffer.open(filename);
+}
+
+SourceLocation SourceManager::location(const char* position) const {
+    //Lines are in buffer order - find the last one starting at or before the position
+    auto itr = upper_bound(m_lines.begin(), m_lines.end(), position, [](const char* target, string_view line) {
+        return target < line.data();
+    });
+    if (itr == m_lines.begin()) {
+        return {0, 0};
+    }
+    --itr;
+    return {static_cast<int>(itr - m_lines.begin()) + 1, static_cast<int>(position - itr->data()) + 1};
+}
@@ -0,0 +1,86 @@
+#include "misc/Arena.h"
+
+#include <cstdint>
+#include <cstring>
+#include <omp.h>
+
+using namespace std;
+
+Arena::Arena(size_t blockSize) : m_blockSize(blockSize), m_pools(omp_get_max_threads()) {}
+
+Arena::~Arena() {
+    release();
+}
+
+Arena::Pool& Arena::localPool() {
+    //Threads outside OpenMP report 0, and teams never outgrow the maximum taken at construction
+    size_t thread = static_cast<size_t>(omp_get_thread_num());
+    return m_pools[thread < m_pools.size() ? thread : 0];
+}
+
+void* Arena::allocate(size_t size, size_t alignment) {
+    Pool& pool = localPool();
+    //Align the cursor, starting a new block if the allocation doesn't fit in the current one
+    auto address = reinterpret_cast<uintptr_t>(pool.cursor);
+    uintptr_t aligned = (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    if (pool.cursor == nullptr || aligned + size > reinterpret_cast<uintptr_t>(pool.end)) {
+        grow(pool, size, alignment);
+        address = reinterpret_cast<uintptr_t>(pool.cursor);
+        aligned = (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    }
+    pool.cursor = reinterpret_cast<char*>(aligned + size);
+    pool.numAllocations++;
+    pool.bytesAllocated += size;
+    return reinterpret_cast<void*>(aligned);
+}
+
+void Arena::grow(Pool& pool, size_t size, size_t alignment) {
+    //Oversized allocations (e.g. a root's child array) get a block of their own
+    size_t blockSize = max(m_blockSize, size + alignment);
+    char* block = static_cast<char*>(::operator new(blockSize));
+    pool.blocks.push_back(block);
+    pool.cursor = block;
+    pool.end = block + blockSize;
+}
+
+string_view Arena::copyString(string_view text) {
+    if (text.empty()) {
+        return {};
+    }
+    char* copy = allocateArray<char>(text.size());
+    memcpy(copy, text.data(), text.size());
+    return {copy, text.size()};
+}
+
+void Arena::release() {
+    for (Pool& pool : m_pools) {
+        for (char* block : pool.blocks) {
+            ::operator delete(block);
+        }
+        pool = Pool();
+    }
+}
+
+size_t Arena::numAllocations() const {
+    size_t total = 0;
+    for (const Pool& pool : m_pools) {
+        total += pool.numAllocations;
+    }
+    return total;
+}
+
+size_t Arena::numBlocks() const {
+    size_t total = 0;
+    for (const Pool& pool : m_pools) {
+        total += pool.blocks.size();
+    }
+    return total;
+}
+
+size_t Arena::bytesAllocated() const {
+    size_t total = 0;
+    for (const Pool& pool : m_pools) {
+        total += pool.bytesAllocated;
+    }
+    return total;
+}
@@ -1,348 +1,366 @@
 #include "parser/Parser.h"
 
-#include <functional>
 #include <utility>
+#include <omp.h>
 
 using namespace std;
 using namespace PTConstants;
 using namespace PT;
+using namespace ParserConstants;
 
-//Constructor and helpers - Initialize all data structure values and parsing templates
-Parser::Parser() {
-    // Initialize the instructionMap with expected lengths of each instruction
-    m_instructionMap.reserve(26);
-    m_instructionMap["move"] = 4;
-    m_instructionMap["load"] = 4;
-    m_instructionMap["store"] = 4;
-    m_instructionMap["create"] = 5;
-    m_instructionMap["cast"] = 3;
-    m_instructionMap["add"] = 6;
-    m_instructionMap["sub"] = 6;
-    m_instructionMap["multiply"] = 6;
-    m_instructionMap["divide"] = 6;
-    m_instructionMap["or"] = 4;
-    m_instructionMap["and"] = 4;
-    m_instructionMap["not"] = 2;
-    m_instructionMap["shift"] = 6;
-    m_instructionMap["compare"] = 4;
-    m_instructionMap["jump"] = 5;
-    m_instructionMap["call"] = 3;
-    m_instructionMap["push"] = 2;
-    m_instructionMap["pop"] = 3;
-    m_instructionMap["return"] = 1;
-    m_instructionMap["stop"] = 1;
-    m_instructionMap["input"] = 4;
-    m_instructionMap["output"] = 2;
-    m_instructionMap["print"] = 2;
-    m_instructionMap["label"] = 2;
-    m_instructionMap["comment"] = 2;
-
-    // Preallocate size for the template map
-        m_templateMap.reserve(26);
-
-    // Move instruction template
-        m_templateMap["move"].reserve(2);
-        m_templateMap["move"].push_back({{"from", 0}, checkImplicitConjunction});
-        m_templateMap["move"].push_back({{"to", 2}, checkExplicitConjunction});
-
-    // Load instruction template
-        m_templateMap["load"].reserve(2);
-        m_templateMap["load"].push_back({{"from", 0}, checkImplicitConjunction});
-        m_templateMap["load"].push_back({{"to", 2}, checkExplicitConjunction});
-
-    // Store instruction template
-        m_templateMap["store"].reserve(2);
-        m_templateMap["store"].push_back({{"from", 0}, checkImplicitConjunction});
-        m_templateMap["store"].push_back({{"to", 2}, checkExplicitConjunction});
-
-    // Create instruction template
-        m_templateMap["create"].reserve(3);
-        m_templateMap["create"].push_back({{"type", 0}, checkImplicitCondition});
-        m_templateMap["create"].push_back({{"from", 1}, checkImplicitConjunction});
-        m_templateMap["create"].push_back({{"to", 3}, checkExplicitConjunction});
-
-    // Cast instruction template
-        m_templateMap["cast"].reserve(2);
-        m_templateMap["cast"].push_back({{"type", 0}, checkImplicitCondition});
-        m_templateMap["cast"].push_back({{"self", 1}, checkImplicitConjunction});
-
-    // Add instruction template
-        m_templateMap["add"].reserve(3);
-        m_templateMap["add"].push_back({{"from", 0}, checkImplicitConjunction});
-        m_templateMap["add"].push_back({{"with", 2}, checkExplicitConjunction});
-        m_templateMap["add"].push_back({{"to", 4}, checkExplicitConjunction});
-
-    // Sub instruction template
-        m_templateMap["sub"].reserve(3);
-        m_templateMap["sub"].push_back({{"from", 0}, checkImplicitConjunction});
-        m_templateMap["sub"].push_back({{"with", 2}, checkExplicitConjunction});
-        m_templateMap["sub"].push_back({{"to", 4}, checkExplicitConjunction});
-
-    // Multiply instruction template
-        m_templateMap["multiply"].reserve(3);
-        m_templateMap["multiply"].push_back({{"from", 0}, checkImplicitConjunction});
-        m_templateMap["multiply"].push_back({{"with", 2}, checkExplicitConjunction});
-        m_templateMap["multiply"].push_back({{"to", 4}, checkExplicitConjunction});
-
-    // Divide instruction template
-        m_templateMap["divide"].reserve(3);
-        m_templateMap["divide"].push_back({{"from", 0}, checkImplicitConjunction});
-        m_templateMap["divide"].push_back({{"with", 2}, checkExplicitConjunction});
-        m_templateMap["divide"].push_back({{"to", 4}, checkExplicitConjunction});
-
-    // Or instruction template
-        m_templateMap["or"].reserve(2);
-        m_templateMap["or"].push_back({{"self", 0}, checkImplicitConjunction});
-        m_templateMap["or"].push_back({{"with", 2}, checkExplicitConjunction});
-
-    // And instruction template
-        m_templateMap["and"].reserve(2);
-        m_templateMap["and"].push_back({{"self", 0}, checkImplicitConjunction});
-        m_templateMap["and"].push_back({{"with", 2}, checkExplicitConjunction});
-
-    // Not instruction template
-        m_templateMap["not"].reserve(1);
-        m_templateMap["not"].push_back({{"self", 0}, checkImplicitConjunction});
-
-    // Shift instruction template
-        m_templateMap["shift"].reserve(3);
-        m_templateMap["shift"].push_back({{"direction", 0}, checkImplicitCondition});
-        m_templateMap["shift"].push_back({{"self", 1}, checkImplicitConjunction});
-        m_templateMap["shift"].push_back({{"by", 3}, checkExplicitConjunction});
-
-    // Compare instruction template
-        m_templateMap["compare"].reserve(2);
-        m_templateMap["compare"].push_back({{"self", 0}, checkImplicitConjunction});
-        m_templateMap["compare"].push_back({{"with", 2}, checkExplicitConjunction});
-
-    // Jump instruction
-        m_templateMap["jump"].reserve(2);
-        m_templateMap["jump"].push_back({{"if", 1}, checkExplicitCondition});
-        m_templateMap["jump"].push_back({{"to", 3}, checkExplicitConjunction});
-
-    // Call instruction
-        m_templateMap["call"].reserve(1);
-        m_templateMap["call"].push_back({{"to", 1}, checkExplicitConjunction});
-
-    // Push instruction
-        m_templateMap["push"].reserve(1);
-        m_templateMap["push"].push_back({{"from", 0}, checkImplicitConjunction});
-
-    // Pop instruction
-        m_templateMap["pop"].reserve(1);
-        m_templateMap["pop"].push_back({{"to", 1}, checkExplicitConjunction});
-
-    // Return instruction
-        m_templateMap["return"].reserve(0);  // No arguments for return
-
-    // Stop instruction
-        m_templateMap["stop"].reserve(0);  // No arguments for stop
-
-    // Input instruction
-        m_templateMap["input"].reserve(2);
-        m_templateMap["input"].push_back({{"type", 0}, checkImplicitCondition});
-        m_templateMap["input"].push_back({{"to", 2}, checkExplicitConjunction});
-
-    // Output instruction template
-        m_templateMap["output"].reserve(1);
-        m_templateMap["output"].push_back({{"from", 0}, checkImplicitConjunction});
-
-    // Print instruction
-        m_templateMap["print"].reserve(1);
-        m_templateMap["print"].push_back({{"from", 0}, checkImplicitConjunction});
-
-    // Comment instruction
-        m_templateMap["comment"].reserve(1);
-        m_templateMap["comment"].push_back({{"static", 0}, checkImplicitConjunction});
-
-    // Label instruction
-        m_templateMap["label"].reserve(1);
-        m_templateMap["label"].push_back({{"static", 0}, checkImplicitConjunction});
-}
+//Constructor - parsing templates live in the compile-time keyword table (lang/Keywords.h), so nothing to build
+Parser::Parser() = default;
 
-bool Parser::parseCode(PT::ParseTree* parseTree, const std::vector<std::string>& codeLines, const std::vector<std::vector<std::pair<std::string, LexerConstants::TokenType>>>& tokens, std::string& errorMessage) {
+//Defined ahead of the three parse paths, its only callers
+template <typename Emit>
+bool Parser::parseLines(const TokenStream& tokens, DiagnosticEngine& diagnostics, Emit&& emitLine) {
     //The parser relies on top-down recursive descent parsing
-    //Preallocate L1 based on codeLines
-    int numTokens = tokens.size();
-    parseTree->getRoot()->reserveChildren(numTokens);
-    for (int i=0; i<numTokens; i++) {
-        //Call validateInstruction in InstructionSet
-        string error = checkInstruction(parseTree, tokens[i]);
-        //If an error is present
-        if (!error.empty()) {
-            errorMessage += "\nInvalid syntax at line " + to_string(i + 1) + ": " + codeLines[i] + "\n" + error + "\n";
+    //Every line parses independently, so lines are parsed in parallel
+    int numLines = tokens.numLines();
+    //Syntax errors, one buffer per thread - each in line order, and merged by line once parsing is done
+    vector<DiagnosticBuffer> threadDiagnostics(omp_get_max_threads());
+    //Once the error limit is known to be reached, the rest of the program is not parsed (it won't be compiled)
+    DiagnosticCutoff cutoff;
+    cutoff.reset(diagnostics.remaining());
+
+    #pragma omp parallel default(none) shared(numLines, threadDiagnostics, tokens, emitLine, cutoff)
+    {
+        DiagnosticBuffer& buffer = threadDiagnostics[omp_get_thread_num()];
+        #pragma omp for schedule(static)
+        for (int i=0; i<numLines; i++) {
+            if (cutoff.reached(i)) {
+                continue;
+            }
+            //Check the line against its instruction's parsing template
+            TokenStream::Line lineTokens = tokens.line(i);
+            ParsedLine parsedLine;
+            SyntaxError error = checkInstruction(parsedLine, lineTokens);
+            //If an error is present, record it, otherwise build the line's tree
+            if (error.code != VALID) {
+                buffer.push_back(syntaxDiagnostic(i, error, lineTokens));
+                cutoff.update(buffer);
+            }
+            else {
+                emitLine(i, parsedLine, lineTokens);
+            }
         }
     }
-    //Concatenate the statusMessage string from the map (which should be ordered already)
-    if (errorMessage.empty()) {
-        return true;
+
+    size_t numErrors = diagnostics.size();
+    diagnostics.report(threadDiagnostics);
+    return diagnostics.size() == numErrors;
+}
+
+bool Parser::parseCode(PT::ParseTree* parseTree, LabelTable& labelTable, const TokenStream& tokens, DiagnosticEngine& diagnostics) {
+    //Each line's subtree goes into its own slot, so worker threads never touch the root
+    vector<PTNode*> lineNodes(tokens.numLines(), nullptr);
+    Arena& arena = parseTree->getArena();
+    vector<ThreadLabels> threadLabels(omp_get_max_threads());
+    bool parsed = parseLines(tokens, diagnostics, [&lineNodes, &arena, &threadLabels](int line, const ParsedLine& parsedLine, const TokenStream::Line& lineTokens) {
+        lineNodes[line] = buildPTLine(arena, threadLabels[omp_get_thread_num()], line, parsedLine, lineTokens);
+    });
+
+    //Attach the line subtrees to the root in line order (lines with a syntax error have none)
+    PTNode* root = parseTree->getRoot();
+    root->reserveChildren(arena, static_cast<int>(lineNodes.size()));
+    for (PTNode* lineNode : lineNodes) {
+        root->insertChild(lineNode);
     }
-    else {
-        return false;
+    mergeLabels(threadLabels, labelTable);
+    return parsed;
+}
+
+bool Parser::parseCodeToAST(AST::AbstractSyntaxTree* abstractSyntaxTree, const ASTBuilder& builder, LabelTable& labelTable, const TokenStream& tokens, DiagnosticEngine& diagnostics) {
+    //Each line's instruction node goes into its own slot, and each thread records the labels it emits
+    vector<AST::InstructionNode*> instructionNodes(tokens.numLines(), nullptr);
+    vector<ThreadLabels> threadLabels(omp_get_max_threads());
+    bool parsed = parseLines(tokens, diagnostics, [&](int line, const ParsedLine& parsedLine, const TokenStream::Line& lineTokens) {
+        instructionNodes[line] = buildASTLine(abstractSyntaxTree, builder, threadLabels[omp_get_thread_num()], line, parsedLine, lineTokens);
+    });
+
+    //Attach the instruction nodes to the root in line order (blank lines have none)
+    AST::RootNode* root = abstractSyntaxTree->getRoot();
+    root->reserveChildren(static_cast<int>(instructionNodes.size()));
+    for (AST::InstructionNode* instructionNode : instructionNodes) {
+        root->insertChild(instructionNode);
+    }
+    mergeLabels(threadLabels, labelTable);
+    return parsed;
+}
+
+bool Parser::parseCodeToProgram(AST::Program* program, LabelTable& labelTable, const TokenStream& tokens, DiagnosticEngine& diagnostics) {
+    //One program entry per line, so worker threads fill disjoint entries
+    program->resize(tokens.numLines());
+    vector<ThreadLabels> threadLabels(omp_get_max_threads());
+    bool parsed = parseLines(tokens, diagnostics, [&](int line, const ParsedLine& parsedLine, const TokenStream::Line& lineTokens) {
+        buildProgramLine(program, threadLabels[omp_get_thread_num()], line, parsedLine, lineTokens);
+    });
+    mergeLabels(threadLabels, labelTable);
+    return parsed;
+}
+
+void Parser::mergeLabels(vector<ThreadLabels>& threadLabels, LabelTable& labelTable) {
+    //Threads parse contiguous blocks in thread order, so taking the tables in thread order keeps them in line order.
+    //Declarations stay split by thread, as the symbol table takes them
+    size_t numUses = labelTable.uses.size();
+    for (const auto& labels : threadLabels) {
+        numUses += labels.uses.size();
+    }
+    labelTable.uses.reserve(numUses);
+    for (auto& labels : threadLabels) {
+        labelTable.definitions.push_back(std::move(labels.definitions));
+        labelTable.uses.insert(labelTable.uses.end(), labels.uses.begin(), labels.uses.end());
+    }
+}
+
+void Parser::recordLabel(ThreadLabels& labels, const ParsedLine& parsedLine, int line, int pos, uint32_t symbol, AST::OperandNode* operand) {
+    //A label instruction's operand declares the label, and also resolves to it like any other use
+    if (parsedLine.keyword->instructionType == ASTConstants::LABEL) {
+        labels.definitions.push_back({symbol, line});
+    }
+    labels.uses.push_back({symbol, line, operand, pos});
+}
+
+PTNode* Parser::buildPTLine(Arena& arena, ThreadLabels& labels, int line, const ParsedLine& parsedLine, const TokenStream::Line& tokens) {
+    if (parsedLine.keyword == nullptr) {
+        return arena.create<GeneralNode>(0, "", BLANK);
+    }
+    //Instruction node, with one conjunction node per operand holding the operand itself
+    PTNode* lineNode = arena.create<GeneralNode>(0, tokens.text(0), INSTRUCTION);
+    lineNode->reserveChildren(arena, parsedLine.numOperands);
+    for (int i=0; i<parsedLine.numOperands; i++) {
+        const ParsedLine::Operand& operand = parsedLine.operands[i];
+        PTNode* conjunctionNode = lineNode->insertChild(arena.create<GeneralNode>(operand.keywordIndex, operand.keyword, CONJUNCTION));
+        conjunctionNode->reserveChildren(arena, 1);
+        //Descriptors carry no decoded value
+        OperandValue value = operand.descriptor ? OperandValue() : tokens.value(operand.index);
+        if (tokens.type(operand.index) == LexerConstants::TokenType::LABEL) {
+            recordLabel(labels, parsedLine, line, i, value.payload.symbol, nullptr);
+        }
+        conjunctionNode->insertChild(arena.create<OperandNode>(operand.index, tokens.text(operand.index), returnPTOperand(tokens.type(operand.index)), value));
+    }
+    return lineNode;
+}
+
+void Parser::buildProgramLine(AST::Program* program, ThreadLabels& labels, int line, const ParsedLine& parsedLine, const TokenStream::Line& tokens) {
+    //Blank lines stay as NONE entries
+    if (parsedLine.keyword == nullptr) {
+        return;
     }
+    program->setInstruction(line, parsedLine.keyword->instructionType, line + 1);
+    for (int i=0; i<parsedLine.numOperands; i++) {
+        const ParsedLine::Operand& operand = parsedLine.operands[i];
+        OperandValue value = operand.descriptor ? OperandValue() : tokens.value(operand.index);
+        LexerConstants::TokenType type = tokens.type(operand.index);
+        //Labels are recorded for the symbol resolver, which fills in their address
+        if (type == LexerConstants::TokenType::LABEL) {
+            recordLabel(labels, parsedLine, line, i, value.payload.symbol, nullptr);
+        }
+        ASTConstants::OperandType operandType = type == LexerConstants::TokenType::LABEL ? ASTConstants::INSTRUCTIONADDRESS : AST::AbstractSyntaxTree::convertOperandType(returnPTOperand(type));
+        program->addOperand(line, operandType, value, tokens.offset(operand.index), static_cast<uint32_t>(tokens.text(operand.index).size()));
+    }
+}
+
+AST::InstructionNode* Parser::buildASTLine(AST::AbstractSyntaxTree* abstractSyntaxTree, const ASTBuilder& builder, ThreadLabels& labels, int line, const ParsedLine& parsedLine, const TokenStream::Line& tokens) {
+    //Blank lines have no instruction node
+    if (parsedLine.keyword == nullptr) {
+        return nullptr;
+    }
+    Arena& arena = abstractSyntaxTree->getArena();
+    AST::InstructionNode* instructionNode = builder.instructionBuilder(arena, parsedLine.keyword->instructionType, tokens.text(0), line + 1);
+    if (instructionNode == nullptr) {
+        return nullptr;
+    }
+    for (int i=0; i<parsedLine.numOperands; i++) {
+        const ParsedLine::Operand& operand = parsedLine.operands[i];
+        OperandValue value = operand.descriptor ? OperandValue() : tokens.value(operand.index);
+        if (tokens.type(operand.index) == LexerConstants::TokenType::LABEL) {
+            //Labels become instruction addresses - the address is filled in by the symbol resolver once every
+            //declaration is known (a label instruction's own operand resolves to itself)
+            auto labelNode = builder.operandBuilder(arena, ASTConstants::INSTRUCTIONADDRESS, tokens.text(operand.index), line + 1, static_cast<short>(i), value);
+            instructionNode->insertChild(labelNode);
+            recordLabel(labels, parsedLine, line, i, value.payload.symbol, labelNode);
+        }
+        else {
+            instructionNode->insertChild(builder.operandBuilder(arena, AST::AbstractSyntaxTree::convertOperandType(returnPTOperand(tokens.type(operand.index))), tokens.text(operand.index), line + 1, static_cast<short>(i), value));
+        }
+    }
+    return instructionNode;
+}
+
+Diagnostic Parser::syntaxDiagnostic(int line, const SyntaxError& error, const TokenStream::Line& tokens) {
+    //Syntax error codes are the diagnostic codes, offset by VALID
+    static_assert(static_cast<int>(UNKNOWN_DESCRIPTOR) - 1 == static_cast<int>(DiagnosticConstants::UNKNOWN_DESCRIPTOR), "Syntax error codes must line up with diagnostic codes");
+    Diagnostic diagnostic{static_cast<DiagnosticConstants::Code>(error.code - 1), line, {}, {}};
+    //Token the error is at (missing tokens are past the end of the line)
+    if (static_cast<size_t>(error.index) < tokens.size()) {
+        diagnostic.token = tokens.text(error.index);
+    }
+    switch (error.code) {
+        //Conjunctions and conditions name the keyword expected
+        case MISSING_CONJUNCTION:
+        case UNKNOWN_CONJUNCTION:
+        case MISSING_CONDITION:
+        case UNKNOWN_CONDITION:
+            diagnostic.detail = error.expected;
+            break;
+        //Operands and descriptors name the token before them
+        case MISSING_OPERAND:
+        case UNKNOWN_OPERAND:
+        case MISSING_DESCRIPTOR:
+        case UNKNOWN_DESCRIPTOR:
+            diagnostic.detail = tokens.text(error.index - 1);
+            break;
+        default:
+            break;
+    }
+    return diagnostic;
 }
 
 //LEVEL 1 - INSTRUCTION PARSER AND CHECKER
-string Parser::checkInstruction(ParseTree* parseTree, vector<pair<string, LexerConstants::TokenType>> tokens) {
-    //Zero case, return instantly with valid syntax and no AST construction
-    if (tokens[0].second == LexerConstants::TokenType::BLANK) {
-        parseTree->getRoot()->insertChild((new GeneralNode(0, "", BLANK)));
-        return "";
+SyntaxError Parser::checkInstruction(ParsedLine& parsedLine, const TokenStream::Line& tokens) {
+    //Zero case, return instantly with valid syntax and no keyword
+    if (tokens.type(0) == LexerConstants::TokenType::BLANK) {
+        return {};
     }
     //If keyword doesn't match, return error no instruction found
-    if (tokens[0].second != LexerConstants::TokenType::INSTRUCTION) {
-        return "Unknown instruction '" + tokens[0].first + "'";
+    if (tokens.type(0) != LexerConstants::TokenType::INSTRUCTION) {
+        return {UNKNOWN_INSTRUCTION, 0, {}};
     }
-    auto itr = m_templateMap.find(tokens[0].first);
-    //If found, go to parse instruction method creating a new instruction node
-    if (itr!= m_templateMap.end()) {
-        return parseInstruction(parseTree, (parseTree->getRoot()->insertChild((new GeneralNode(0, tokens[0].first, INSTRUCTION)))), tokens, itr->second);
+    const Keywords::Keyword* keyword = Keywords::lookup(tokens.text(0));
+    //If found, go to parse instruction method with the instruction's parsing template
+    if (keyword != nullptr && keyword->instructionType != ASTConstants::NONE) {
+        parsedLine.keyword = keyword;
+        return parseInstruction(parsedLine, tokens, keyword->grammar);
     }
     else {
         //Edge case, valid instruction with no method implemented (debug)
-        return "Compiler error for '" + tokens[0].first + "'. Could not find instruction parsing method.";
+        return {MISSING_PARSING_METHOD, 0, {}};
     }
 }
 
-string Parser::parseInstruction(ParseTree* parseTree, PTNode* node, std::vector<std::pair<std::string, LexerConstants::TokenType>> tokens, std::vector<std::pair<std::pair<std::string, int>, std::function<std::string(ParseTree*, PTNode*, std::vector<std::pair<std::string, LexerConstants::TokenType>>, std::string&, int)>>> parsingTemplate) {
-    //Temporary return string
-    string returnString;
+SyntaxError Parser::parseInstruction(ParsedLine& parsedLine, const TokenStream::Line& tokens, const Keywords::Grammar& grammar) {
     //Loop through all templates
-    //NOTE - if the instruction is a no operand (i.e. empty parsingTemplate) loop will not run and will go straight to final check
-    for (auto& templateElement : parsingTemplate) {
-        //Access the parsing function, passing the index expected in the token sequence
-        returnString = templateElement.second(parseTree, node, tokens, templateElement.first.first, templateElement.first.second);
+    //NOTE - if the instruction is a no operand (i.e. empty grammar) loop will not run and will go straight to final check
+    for (size_t i = 0; i < grammar.numElements; i++) {
+        const Keywords::GrammarElement& templateElement = grammar.elements[i];
+        //Dispatch to the parsing function, passing the index expected in the token sequence
+        SyntaxError error;
+        switch (templateElement.check) {
+            case Keywords::IMPLICIT_CONJUNCTION:
+                error = checkImplicitConjunction(parsedLine, tokens, templateElement.keyword, templateElement.index);
+                break;
+            case Keywords::IMPLICIT_CONDITION:
+                error = checkImplicitCondition(parsedLine, tokens, templateElement.keyword, templateElement.index);
+                break;
+            case Keywords::EXPLICIT_CONJUNCTION:
+                error = checkExplicitConjunction(parsedLine, tokens, templateElement.keyword, templateElement.index);
+                break;
+            case Keywords::EXPLICIT_CONDITION:
+                error = checkExplicitCondition(parsedLine, tokens, templateElement.keyword, templateElement.index);
+                break;
+        }
         //If an error arises, return instantly
-        if (!returnString.empty()) {
-            return returnString;
+        if (error.code != VALID) {
+            return error;
         }
-        //Clear return string on every iteration
-        returnString.clear();
     }
 
     //Final check - syntax correct but there's excess tokens present
-    //Find size of template expected through instructionMap lookup
-    auto itr = m_instructionMap.find(tokens[0].first);
-    if(itr!=m_instructionMap.end()) {
-        //If tokens exceed expected size
-        if (tokens.size() > itr->second) {
-            return "Excess tokens at and past '" + tokens[tokens.size()].first + "' found.";
-        }
-        else {
-            //Correct syntax
-            return "";
-        }
-    }
-    else {
-        //Compiler error - edge case with valid instruction not in hash table
-        return "Compiler error for '" + tokens[0].first + "'. Could not find instruction information.";
+    if (tokens.size() > grammar.numTokens) {
+        return {EXCESS_TOKENS, static_cast<int>(grammar.numTokens), {}};
     }
-
+    //Correct syntax
+    return {};
 }
 
 
 
 //LEVEL 2 - CONJUNCTION AND CONDITION CHECKERS / PARSER HELPERS
-string Parser::checkImplicitConjunction(ParseTree* parseTree, PTNode* node, vector<pair<string, LexerConstants::TokenType>> tokens, string& keyword, int index) {
-    string returnString;
+SyntaxError Parser::checkImplicitConjunction(ParsedLine& parsedLine, const TokenStream::Line& tokens, string_view keyword, int index) {
     //Implicit node is implicit, so always exists
-    //Add keyword as child
-    //Rewrite returnString if L2 analysis returns an error
-    returnString = parseConjunction(parseTree, node->insertChild((new GeneralNode(Constants::IMPLICIT_INDEX, keyword, CONJUNCTION))), tokens, keyword, index);
-    return returnString;
+    //Return the result of L2 analysis
+    return parseConjunction(parsedLine, tokens, keyword, Constants::IMPLICIT_INDEX, index);
 }
 
-string Parser::checkImplicitCondition(ParseTree* parseTree, PTNode* node, vector<pair<string, LexerConstants::TokenType>> tokens, string& keyword, int index) {
-    string returnString;
+SyntaxError Parser::checkImplicitCondition(ParsedLine& parsedLine, const TokenStream::Line& tokens, string_view keyword, int index) {
     //Implicit node is implicit, so always exists
-    //Add keyword as child
-    //Rewrite returnString if L2 analysis returns an error
-    returnString = parseCondition(parseTree, node->insertChild((new GeneralNode(Constants::IMPLICIT_INDEX, keyword, CONJUNCTION))), tokens, keyword, index);
-    return returnString;
+    //Return the result of L2 analysis
+    return parseCondition(parsedLine, tokens, keyword, Constants::IMPLICIT_INDEX, index);
 }
 
-string Parser::checkExplicitConjunction(ParseTree* parseTree, PTNode* node, vector<pair<string, LexerConstants::TokenType>> tokens, string& keyword, int index) {
-    string returnString;
+SyntaxError Parser::checkExplicitConjunction(ParsedLine& parsedLine, const TokenStream::Line& tokens, string_view keyword, int index) {
     //Check if a conjunction exists by comparing size
-    if (tokens.size()<=index) {
-        return "Missing conjunction. Expected '" + keyword + "'";
+    if (tokens.size()<=static_cast<size_t>(index)) {
+        return {MISSING_CONJUNCTION, index, keyword};
     }
     //Check if to keyword is valid
-    else if (tokens[index].first != keyword) {
-        return "Unknown conjunction '" + tokens[index].first + "'. Expected '" + keyword + "'";
+    else if (tokens.text(index) != keyword) {
+        return {UNKNOWN_CONJUNCTION, index, keyword};
     }
-    //If passed, add to keyword as child
-    //Rewrite returnString if L2 analysis returns an error
+    //If passed, return the result of L2 analysis
     else {
-        returnString = parseConjunction(parseTree, node->insertChild((new GeneralNode(index, keyword, CONJUNCTION))), tokens, keyword, index);
-        return returnString;
+        return parseConjunction(parsedLine, tokens, keyword, index, index);
     }
 }
 
-string Parser::checkExplicitCondition(ParseTree* parseTree, PTNode* node, vector<pair<string, LexerConstants::TokenType>> tokens, string& keyword, int index) {
-    string returnString;
+SyntaxError Parser::checkExplicitCondition(ParsedLine& parsedLine, const TokenStream::Line& tokens, string_view keyword, int index) {
     //Check if a condition exists by comparing size
-    if (tokens.size()<=index) {
-        return "Missing condition. Expected '" + keyword + "'";
+    if (tokens.size()<=static_cast<size_t>(index)) {
+        return {MISSING_CONDITION, index, keyword};
     }
     //Check if to keyword is valid
-    else if (tokens[index].first != keyword) {
-        return "Unknown condition '" + tokens[index].first + "'. Expected '" + keyword + "'";
+    else if (tokens.text(index) != keyword) {
+        return {UNKNOWN_CONDITION, index, keyword};
     }
-    //If passed, add to keyword as child
-    //Rewrite returnString if L2 analysis returns an error
+    //If passed, return the result of L2 analysis
     else {
-        returnString = parseCondition(parseTree, node->insertChild((new GeneralNode(index, keyword, CONJUNCTION))), tokens, keyword, index);
-        return returnString;
+        return parseCondition(parsedLine, tokens, keyword, index, index);
     }
 }
 
-string Parser::parseConjunction(ParseTree* parseTree, PTNode* node, vector<pair<string, LexerConstants::TokenType>> tokens, string& keyword, int index) {
-    //Create temporary return string
-    string returnString;
+SyntaxError Parser::parseConjunction(ParsedLine& parsedLine, const TokenStream::Line& tokens, string_view keyword, int keywordIndex, int index) {
     //Increment index by one to now point to where the operand should be
     index++;
     //If the operand does not exist after the keyword, return an error
-    if(tokens.size()<=index) {
-        return "Missing operand after '" + tokens[index-1].first + "'";
+    if(tokens.size()<=static_cast<size_t>(index)) {
+        return {MISSING_OPERAND, index, {}};
     }
     //If the token in the operand position is not an operand, return an error
-    else if (!isOperand(tokens[index])) {
-        return "Unknown operand '" + tokens[index].first + "' after '" + tokens[index-1].first + "'";
+    else if (!isOperand(tokens.type(index))) {
+        return {UNKNOWN_OPERAND, index, {}};
     }
     else {
-        //Insert a new child as the operand
-        node->insertChild((new OperandNode(index, tokens[index].first, returnPTOperand(tokens[index].second))));
-        return "";
+        //Record the operand
+        parsedLine.operands[parsedLine.numOperands++] = {keyword, keywordIndex, index, false};
+        return {};
     }
 }
 
-string Parser::parseCondition(ParseTree* parseTree, PTNode* node, vector<pair<string, LexerConstants::TokenType>> tokens, string& keyword, int index) {
-    //Create temporary return string
-    string returnString;
+SyntaxError Parser::parseCondition(ParsedLine& parsedLine, const TokenStream::Line& tokens, string_view keyword, int keywordIndex, int index) {
     //Iterate the index to now point to where the condition should be
     index++;
     //If the descriptor after keyword does not exist
-    if(tokens.size()<=index) {
-        return "Missing descriptor after '" + tokens[index-1].first + "'";
+    if(tokens.size()<=static_cast<size_t>(index)) {
+        return {MISSING_DESCRIPTOR, index, {}};
     }
     //If the token after keyword does not match as a descriptor
-    else if (!isDescriptor(tokens[index])) {
-        return "Unknown descriptor '" + tokens[index].first + "' after '" + tokens[index-1].first + "'";
+    else if (!isDescriptor(tokens.type(index))) {
+        return {UNKNOWN_DESCRIPTOR, index, {}};
     }
     else {
-        //Insert a new child as the operand
-        node->insertChild((new OperandNode(index, tokens[index].first, returnPTOperand(tokens[index].second))));
-        return "";
+        //Record the descriptor
+        parsedLine.operands[parsedLine.numOperands++] = {keyword, keywordIndex, index, true};
+        return {};
     }
 }
 
 
 
 //LEVEL 3 - OPERANDS AND DESCRIPTORS
-bool Parser::isOperand(pair<string, LexerConstants::TokenType>& token) {
+bool Parser::isOperand(LexerConstants::TokenType tokenType) {
     //Switch statement to determine if a lexer constant constitutes an operand in the PT
-    switch (token.second) {
+    switch (tokenType) {
         case LexerConstants::TokenType::REGISTER:
         case LexerConstants::TokenType::INSTRUCTIONADDRESS:
         case LexerConstants::TokenType::MEMORYADDRESS:
@@ -359,10 +377,10 @@ bool Parser::isOperand(pair<string, LexerConstants::TokenType>& token) {
     }
 }
 
-bool Parser::isDescriptor(pair<string, LexerConstants::TokenType>& token) {
+bool Parser::isDescriptor(LexerConstants::TokenType tokenType) {
     //Check if token is a condition
     //Switch statement
-    switch (token.second) {
+    switch (tokenType) {
         case LexerConstants::TokenType::JUMPCONDITION:
         case LexerConstants::TokenType::SHIFTCONDITION:
         case LexerConstants::TokenType::TYPECONDITION:
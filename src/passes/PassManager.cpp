@@ -0,0 +1,64 @@
+#include "passes/PassManager.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <omp.h>
+
+using namespace std;
+
+void PassManager::addPass(Pass* pass) {
+    if (pass != nullptr) {
+        m_passes.push_back(pass);
+    }
+}
+
+bool PassManager::run(AST::RootNode* root, DiagnosticEngine& diagnostics) {
+    //One context per pass per thread, created up front so workers never allocate them
+    int numThreads = omp_get_max_threads();
+    vector<vector<unique_ptr<PassContext>>> contexts(m_passes.size());
+    //One cutoff for every pass, so the error limit keeps the lowest-numbered diagnostics of all of them
+    DiagnosticCutoff cutoff;
+    cutoff.reset(diagnostics.remaining());
+    for (size_t i=0; i<m_passes.size(); i++) {
+        m_passes[i]->begin(cutoff);
+        contexts[i].resize(numThreads);
+        for (auto& context : contexts[i]) {
+            context = m_passes[i]->createContext();
+        }
+    }
+
+    //Single sweep - each thread walks its own contiguous block, running every pass on a batch while it is in cache
+    const vector<AST::ASTNode*>& children = root->getChildren();
+    size_t numChildren = children.size();
+    #pragma omp parallel default(none) shared(children, numChildren, contexts)
+    {
+        size_t thread = omp_get_thread_num();
+        size_t teamSize = omp_get_num_threads();
+        size_t blockBegin = numChildren * thread / teamSize;
+        size_t blockEnd = numChildren * (thread + 1) / teamSize;
+        for (size_t batch = blockBegin; batch < blockEnd; batch += BATCH_SIZE) {
+            AST::ASTNode* const* begin = children.data() + batch;
+            AST::ASTNode* const* end = children.data() + min(batch + BATCH_SIZE, blockEnd);
+            for (size_t i=0; i<m_passes.size(); i++) {
+                m_passes[i]->visitRange(begin, end, contexts[i][thread].get());
+            }
+        }
+    }
+
+    //Merge thread contexts and collect every pass's diagnostics, reported in one merge by line (on a shared line, in
+    //registration order) so the report doesn't depend on thread timing
+    vector<DiagnosticBuffer> threadDiagnostics;
+    for (size_t i=0; i<m_passes.size(); i++) {
+        for (auto& context : contexts[i]) {
+            if (context != nullptr) {
+                m_passes[i]->mergeContext(context.get());
+            }
+        }
+        m_passes[i]->finish(threadDiagnostics);
+    }
+    size_t numErrors = diagnostics.size();
+    diagnostics.report(threadDiagnostics);
+    return diagnostics.size() == numErrors;
+}
@@ -2,56 +2,47 @@
 
 namespace PT {
     // PTNode Implementation
-    PTNode::PTNode(int tokenIndex, std::string nodeValue, PTConstants::NodeType nodeType)
+    PTNode::PTNode(int tokenIndex, std::string_view nodeValue, PTConstants::NodeType nodeType)
             : m_tokenIndex(tokenIndex), m_nodeValue(nodeValue), m_nodeType(nodeType) {}
 
-    PTNode::~PTNode() {
-        for (int i = 0; i < m_children.size(); i++) {
-            delete m_children[i];
-        }
-        m_children.clear();
-    }
-
     PTNode* PTNode::insertChild(PTNode* childNode) {
-        if (childNode != nullptr) {
-            m_children.push_back(childNode);
+        if (childNode != nullptr && m_numChildren < m_childCapacity) {
+            m_children[m_numChildren++] = childNode;
             return childNode;
         } else {
             return nullptr;
         }
     }
 
-    void PTNode::deleteLastChild() {
-        delete m_children.back();
-        m_children.pop_back();
-    }
-
-    PTNode* PTNode::childAt(int index) {
-        if (index >= m_children.size()) {
+    PTNode* PTNode::childAt(int index) const {
+        if (index >= m_numChildren) {
             return nullptr;
         } else {
             return m_children[index];
         }
     }
 
+    void PTNode::reserveChildren(Arena& arena, int numChildren) {
+        //Child lists are only ever sized once, before any child is inserted
+        m_children = arena.allocateArray<PTNode*>(numChildren);
+        m_childCapacity = numChildren;
+        m_numChildren = 0;
+    }
+
     // RootNode Implementation
     RootNode::RootNode() : PTNode(PTConstants::Constants::IMPLICIT_INDEX, "", PTConstants::ROOT) {}
 
     // GeneralNode Implementation
-    GeneralNode::GeneralNode(int tokenIndex, std::string nodeValue, PTConstants::GeneralType generalType)
+    GeneralNode::GeneralNode(int tokenIndex, std::string_view nodeValue, PTConstants::GeneralType generalType)
             : PTNode(tokenIndex, nodeValue, PTConstants::GENERAL), m_generalType(generalType) {}
 
     // OperandNode Implementation
-    OperandNode::OperandNode(int tokenIndex, std::string nodeValue, PTConstants::OperandType operandType)
-            : PTNode(tokenIndex, nodeValue, PTConstants::OPERAND), m_operandType(operandType) {}
+    OperandNode::OperandNode(int tokenIndex, std::string_view nodeValue, PTConstants::OperandType operandType, const OperandValue& value)
+            : PTNode(tokenIndex, nodeValue, PTConstants::OPERAND), m_operandType(operandType), m_value(value) {}
 
     // ParseTree Implementation
     ParseTree::ParseTree() {
-        m_root = new RootNode();
-    }
-
-    ParseTree::~ParseTree() {
-        delete m_root;
+        m_root = m_arena.create<RootNode>();
     }
 
     void ParseTree::printTree() const {
@@ -64,10 +55,8 @@ namespace PT {
         std::string indent(level * 4, ' ');
         std::cout << indent << node->getNodeValue() << "(" << node->getIndex() << ")" << std::endl;
 
-        for (const auto& child : node->getChildren()) {
-            if (child != nullptr) {
-                printNode(child, level + 1);
-            }
+        for (int i = 0; i < node->getNumChildren(); i++) {
+            printNode(node->childAt(i), level + 1);
         }
     }
 }
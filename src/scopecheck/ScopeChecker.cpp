@@ -2,74 +2,111 @@
 
 #include <string>
 #include <vector>
-#include <regex>
+#include <utility>
+#include <omp.h>
 
 using namespace std;
 
-ScopeChecker::ScopeChecker(std::vector<std::string> &lines): m_codeLines(lines) {};
+ScopeChecker::ScopeChecker(const SourceManager &source): m_source(source) {};
 
-bool ScopeChecker::checkAddressScopes(AST::ASTNode *AST, std::string &errorMessage, const std::vector<std::string> &codeLines) {
-    //Set the code lines to the given argument
-    m_codeLines = codeLines;
+void ScopeChecker::begin(DiagnosticCutoff& cutoff) {
+    m_cutoff = &cutoff;
+}
 
-    //Visit the root and iterate over the AST
-    AST->accept(*this);
+std::unique_ptr<PassContext> ScopeChecker::createContext() {
+    return std::make_unique<ThreadContext>();
+}
 
-    //Concatenate status message string with all error messages
-    for (const auto& pair : m_invalidLines) {
-        errorMessage += pair.second;
+void ScopeChecker::visitRange(AST::ASTNode* const* begin, AST::ASTNode* const* end, PassContext* context) {
+    auto& threadContext = static_cast<ThreadContext&>(*context);
+    for (auto* child = begin; child != end; ++child) {
+        auto* instructionNode = static_cast<AST::InstructionNode*>(*child);
+        //Ranges are in line order, so the rest of this one is past the cutoff too
+        if (m_cutoff->reached(instructionNode->getLine() - 1)) {
+            return;
+        }
+        //Only registers and addresses have a scope - every other operand passes
+        for (auto* operand : instructionNode->getChildren()) {
+            auto* operandNode = static_cast<AST::OperandNode*>(operand);
+            if (!inScope(operandNode->getOperandType(), operandNode->getValue())) {
+                threadContext.diagnostics.push_back(scopeError(operandNode->getLine(), operandNode->getOperandType(), operandNode->getValue(), operandNode->getNodeView()));
+                m_cutoff->update(threadContext.diagnostics);
+            }
+        }
     }
+}
 
-    //Return true if no errors, false otherwise
-    if (!errorMessage.empty()) {
-        return false;
-    }
-    return true;
+void ScopeChecker::mergeContext(PassContext* context) {
+    //Every line belongs to one thread, so the buffers never overlap
+    m_threadDiagnostics.push_back(std::move(static_cast<ThreadContext&>(*context).diagnostics));
 }
 
+void ScopeChecker::finish(std::vector<DiagnosticBuffer>& diagnostics) {
+    for (auto& buffer : m_threadDiagnostics) {
+        diagnostics.push_back(std::move(buffer));
+    }
+    m_threadDiagnostics.clear();
+}
 
-void ScopeChecker::visit(AST::RegisterOperand& node) {
-    int line = node.getLine();
-    // Run a regex template (this one with explicit bounds) to determine if the operand is in scope
-    if (!std::regex_match(node.getNodeValue(), registerTemplate)) {
-#pragma omp critical
-        {
-            m_invalidLines[line] += "\nScope error at line " + std::to_string(line + 1) + ": " + m_codeLines[line] + "\n" + "Register '" + node.getNodeValue() + "' is out of range. Max register is r9\n";
+void ScopeChecker::checkProgram(const AST::Program& program, DiagnosticCutoff& cutoff, std::vector<DiagnosticBuffer>& diagnostics) {
+    //Every operand slot is independent - check them all in one loop over the program, each thread into its own buffer
+    int numInstructions = static_cast<int>(program.size());
+    std::vector<DiagnosticBuffer> threadDiagnostics(omp_get_max_threads());
+    #pragma omp parallel default(none) shared(program, numInstructions, threadDiagnostics, cutoff)
+    {
+        DiagnosticBuffer& buffer = threadDiagnostics[omp_get_thread_num()];
+        #pragma omp for schedule(static)
+        for (int i=0; i<numInstructions; i++) {
+            //Entry n is on line index n
+            if (cutoff.reached(i)) {
+                continue;
+            }
+            for (int j=0; j<program.getNumOperands(i); j++) {
+                ASTConstants::OperandType type = program.getOperandType(i, j);
+                OperandValue value = program.getOperandValue(i, j);
+                if (!inScope(type, value)) {
+                    buffer.push_back(scopeError(program.getLine(i), type, value, program.getOperandView(i, j, m_source)));
+                    cutoff.update(buffer);
+                }
+            }
         }
     }
+    for (auto& buffer : threadDiagnostics) {
+        diagnostics.push_back(std::move(buffer));
+    }
 }
 
-void ScopeChecker::visit(AST::MemoryAddressOperand& node) {
-    int line = node.getLine();
-    if (!std::regex_match(node.getNodeValue(), memoryTemplate)) {
-#pragma omp critical
-        {
-            m_invalidLines[line] += "\nScope error at line " + std::to_string(line + 1) + ": " + m_codeLines[line] + "\n" + "Memory address '" + node.getNodeValue() + "' is out of range. Max address is m<999999999>\n";
-        }
+bool ScopeChecker::inScope(ASTConstants::OperandType type, const OperandValue& value) const {
+    switch (type) {
+        // Compare the register index decoded by the lexer against the last register
+        case ASTConstants::REGISTER:
+            return !value.overflow && value.payload.address <= MAX_REGISTER;
+        case ASTConstants::MEMORYADDRESS:
+            return !value.overflow && value.payload.address <= MAX_ADDRESS;
+        // Instruction address both has to adhere to StartASM bounds (4 byte address) and the number of instructions themselves
+        case ASTConstants::INSTRUCTIONADDRESS:
+            return !value.overflow && value.payload.address <= m_source.numLines() && value.payload.address <= MAX_ADDRESS;
+        default:
+            return true;
     }
 }
 
-void ScopeChecker::visit(AST::InstructionAddressOperand& node) {
-    int line = node.getLine();
-    // Instruction address both has to adhere to StartASM bounds (4 byte address) and the number of instructions themselves
-    // First get the actual instruction index
-    std::string localInstructionIndex;
-    for (int k = 2; k < node.getNodeValue().size() - 1; k++) {
-        localInstructionIndex += node.getNodeValue()[k];
+Diagnostic ScopeChecker::scopeError(int line, ASTConstants::OperandType type, const OperandValue& value, std::string_view operandText) const {
+    DiagnosticConstants::Code code;
+    if (type == ASTConstants::REGISTER) {
+        code = DiagnosticConstants::REGISTER_SCOPE;
     }
-    // If the given instruction index is greater than the number of lines
-    if ((std::stoi(localInstructionIndex) > m_codeLines.size())) {
-#pragma omp critical
-        {
-            m_invalidLines[line] += "\nScope error at line " + std::to_string(line + 1) + ": " + m_codeLines[line] + "\n" + "Instruction address '" + node.getNodeValue() + "' is out of range. Expected i[0]-i[" + std::to_string(m_codeLines.size()) + "]\n";
-        }
+    else if (type == ASTConstants::MEMORYADDRESS) {
+        code = DiagnosticConstants::MEMORY_SCOPE;
     }
-        // If the instruction index is larger than the StartASM limit
-    else if (!std::regex_match(node.getNodeValue(), instructionTemplate)) {
-#pragma omp critical
-        {
-            m_invalidLines[line] += "\nScope error at line " + std::to_string(line + 1) + ": " + m_codeLines[line] + "\n" + "Instruction address '" + node.getNodeValue() + "' is out of range. Max address is i[999999999]\n";
-        }
+    // If the given instruction index is greater than the number of lines (or too large to decode at all)
+    else if (value.overflow || value.payload.address > m_source.numLines()) {
+        code = DiagnosticConstants::INSTRUCTION_SCOPE;
+    }
+    // If the instruction index is larger than the StartASM limit
+    else {
+        code = DiagnosticConstants::INSTRUCTION_LIMIT;
     }
+    //AST lines count from 1
+    return Diagnostic::operand(code, line - 1, operandText, value);
 }
-
@@ -2,424 +2,180 @@
 
 #include <string>
 #include <vector>
+#include <array>
+#include <utility>
+#include <omp.h>
 
 using namespace std;
 using namespace AST;
 using namespace ASTConstants;
 
-SemanticAnalyzer::SemanticAnalyzer(std::vector<std::string>& lines) : m_lines(lines) {
-    // Initialization code if needed
-}
-bool SemanticAnalyzer::analyzeSemantics(AST::ASTNode *AST, std::string &errorMessage) {
-    //Prepopulate the local semantic context - an operation will never have >3 operands
-    std::vector<ASTConstants::OperandType> localContext(3, ASTConstants::EMPTY); //Set initial operands to empty for easier matching
-    //Perallocate the global semantic context based on the number of lines
-    m_semanticContext = std::vector<std::vector<ASTConstants::OperandType>>(m_lines.size()+1, localContext);
-
-    //Visit the root and iterate over the AST
-    AST->accept(*this);
-
-    //Clear the context
-    m_semanticContext.clear();
-
-    //Concatenate status message string with all error messages
-    for (const auto& pair : m_invalidLines) {
-        errorMessage += pair.second;
-    }
-
-    //Return true if no errors, false otherwise
-    if (!errorMessage.empty()) {
-        return false;
-    }
-    return true;
-}
-
-void SemanticAnalyzer::visit(AST::RootNode& node)  {}
-
-void SemanticAnalyzer::visit(AST::MoveInstruction& node) {
-    //CASE 1 - Atomic type instruction
-    //Expected semantic structure of instruction
-    const vector<ASTConstants::OperandType> semanticTemplate = {REGISTER, REGISTER, EMPTY};
-    int line = node.getLine();
-    //Check local semantic context
-    if (m_semanticContext[line] == semanticTemplate) {
-        return; //Return instantly if match found
-    }
-    //Pass to error handler if a match isn't found
-    handleAtomicInstructionError(line, semanticTemplate, node);
-}
-
-void SemanticAnalyzer::visit(AST::CastInstruction& node) {
-    const std::vector<ASTConstants::OperandType> semanticTemplate = {TYPECONDITION, REGISTER, EMPTY};
-    int line = node.getLine();
-    if (m_semanticContext[line] == semanticTemplate) {
-        return;
-    }
-    handleAtomicInstructionError(line, semanticTemplate, node);
-}
-
-void SemanticAnalyzer::visit(AST::AddInstruction& node) {
-    const std::vector<ASTConstants::OperandType> semanticTemplate = {REGISTER, REGISTER, REGISTER};
-    int line = node.getLine();
-    if (m_semanticContext[line] == semanticTemplate) {
-        return;
-    }
-    handleAtomicInstructionError(line, semanticTemplate, node);
-}
-
-void SemanticAnalyzer::visit(AST::SubInstruction& node) {
-    const std::vector<ASTConstants::OperandType> semanticTemplate = {REGISTER, REGISTER, REGISTER};
-    int line = node.getLine();
-    if (m_semanticContext[line] == semanticTemplate) {
-        return;
-    }
-    handleAtomicInstructionError(line, semanticTemplate, node);
-}
-
-void SemanticAnalyzer::visit(AST::MultiplyInstruction& node) {
-    const std::vector<ASTConstants::OperandType> semanticTemplate = {REGISTER, REGISTER, REGISTER};
-    int line = node.getLine();
-    if (m_semanticContext[line] == semanticTemplate) {
-        return;
-    }
-    handleAtomicInstructionError(line, semanticTemplate, node);
-}
-
-void SemanticAnalyzer::visit(AST::DivideInstruction& node) {
-    const std::vector<ASTConstants::OperandType> semanticTemplate = {REGISTER, REGISTER, REGISTER};
-    int line = node.getLine();
-    if (m_semanticContext[line] == semanticTemplate) {
-        return;
-    }
-    handleAtomicInstructionError(line, semanticTemplate, node);
-}
-
-void SemanticAnalyzer::visit(AST::OrInstruction& node) {
-    const std::vector<ASTConstants::OperandType> semanticTemplate = {REGISTER, REGISTER, EMPTY};
-    int line = node.getLine();
-    if (m_semanticContext[line] == semanticTemplate) {
-        return;
-    }
-    handleAtomicInstructionError(line, semanticTemplate, node);
-}
-
-void SemanticAnalyzer::visit(AST::AndInstruction& node) {
-    const std::vector<ASTConstants::OperandType> semanticTemplate = {REGISTER, REGISTER, EMPTY};
-    int line = node.getLine();
-    if (m_semanticContext[line] == semanticTemplate) {
-        return;
-    }
-    handleAtomicInstructionError(line, semanticTemplate, node);
-}
+//Operand signatures, packed at compile time from the instruction set (lang/InstructionSet.h)
+namespace {
+    using InstructionSet::SlotSignature;
+    using InstructionSet::INSTRUCTIONS;
 
-void SemanticAnalyzer::visit(AST::NotInstruction& node) {
-    const std::vector<ASTConstants::OperandType> semanticTemplate = {REGISTER, EMPTY, EMPTY};
-    int line = node.getLine();
-    if (m_semanticContext[line] == semanticTemplate) {
-        return;
-    }
-    handleAtomicInstructionError(line, semanticTemplate, node);
-}
+    //Bits per operand slot in a packed context or signature (one per operand type)
+    constexpr int SLOT_BITS = 16;
+    static_assert(EMPTY < SLOT_BITS, "Every operand type needs a bit in its slot");
 
-void SemanticAnalyzer::visit(AST::ShiftInstruction& node) {
-    const std::vector<ASTConstants::OperandType> semanticTemplate = {SHIFTCONDITION, REGISTER, REGISTER};
-    int line = node.getLine();
-    if (m_semanticContext[line] == semanticTemplate) {
-        return;
-    }
-    handleAtomicInstructionError(line, semanticTemplate, node);
-}
-
-void SemanticAnalyzer::visit(AST::CompareInstruction& node) {
-    const std::vector<ASTConstants::OperandType> semanticTemplate = {REGISTER, REGISTER, EMPTY};
-    int line = node.getLine();
-    if (m_semanticContext[line] == semanticTemplate) {
-        return;
-    }
-    handleAtomicInstructionError(line, semanticTemplate, node);
-}
-
-void SemanticAnalyzer::visit(AST::PushInstruction& node) {
-    const std::vector<ASTConstants::OperandType> semanticTemplate = {REGISTER, EMPTY, EMPTY};
-    int line = node.getLine();
-    if (m_semanticContext[line] == semanticTemplate) {
-        return;
-    }
-    handleAtomicInstructionError(line, semanticTemplate, node);
-}
-
-void SemanticAnalyzer::visit(AST::PopInstruction& node) {
-    const std::vector<ASTConstants::OperandType> semanticTemplate = {REGISTER, EMPTY, EMPTY};
-    int line = node.getLine();
-    if (m_semanticContext[line] == semanticTemplate) {
-        return;
-    }
-    handleAtomicInstructionError(line, semanticTemplate, node);
-}
-
-void SemanticAnalyzer::visit(AST::ReturnInstruction& node) {
-    const std::vector<ASTConstants::OperandType> semanticTemplate = {EMPTY, EMPTY, EMPTY};
-    int line = node.getLine();
-    if (m_semanticContext[line] == semanticTemplate) {
-        return;
-    }
-    handleAtomicInstructionError(line, semanticTemplate, node);
-}
-
-void SemanticAnalyzer::visit(AST::StopInstruction& node) {
-    const std::vector<ASTConstants::OperandType> semanticTemplate = {EMPTY, EMPTY, EMPTY};
-    int line = node.getLine();
-    if (m_semanticContext[line] == semanticTemplate) {
-        return;
+    constexpr uint64_t slotMask(const SlotSignature& signature) {
+        uint64_t mask = 0;
+        for (int i=0; i<signature.numTypes; i++) {
+            mask |= uint64_t(1) << signature.types[i];
+        }
+        return mask;
     }
-    handleAtomicInstructionError(line, semanticTemplate, node);
-}
 
-void SemanticAnalyzer::visit(AST::InputInstruction& node) {
-    const std::vector<ASTConstants::OperandType> semanticTemplate = {TYPECONDITION, REGISTER, EMPTY};
-    int line = node.getLine();
-    if (m_semanticContext[line] == semanticTemplate) {
-        return;
-    }
-    handleAtomicInstructionError(line, semanticTemplate, node);
+    //Every signature packed into one word, with slot i in bits [i*SLOT_BITS, (i+1)*SLOT_BITS). Blank entries (NONE)
+    //expect no operands
+    constexpr array<uint64_t, NONE + 1> SIGNATURE_MASKS = [] {
+        array<uint64_t, NONE + 1> masks{};
+        for (size_t i=0; i<masks.size(); i++) {
+            for (int j=0; j<InstructionSet::MAX_OPERANDS; j++) {
+                masks[i] |= slotMask(INSTRUCTIONS[i].operands[j]) << (j * SLOT_BITS);
+            }
+        }
+        return masks;
+    }();
 }
 
-void SemanticAnalyzer::visit(AST::OutputInstruction& node) {
-    const std::vector<ASTConstants::OperandType> semanticTemplate = {REGISTER, EMPTY, EMPTY};
-    int line = node.getLine();
-    if (m_semanticContext[line] == semanticTemplate) {
-        return;
-    }
-    handleAtomicInstructionError(line, semanticTemplate, node);
+SemanticAnalyzer::SemanticAnalyzer(const SourceManager& source) : m_source(source) {
+    // Initialization code if needed
 }
 
-void SemanticAnalyzer::visit(AST::LabelInstruction& node) {
-    const std::vector<ASTConstants::OperandType> semanticTemplate = {INSTRUCTIONADDRESS, EMPTY, EMPTY};
-    int line = node.getLine();
-    if (m_semanticContext[line] == semanticTemplate) {
-        return;
-    }
-    handleAtomicInstructionError(line, semanticTemplate, node);
+void SemanticAnalyzer::begin(DiagnosticCutoff& cutoff) {
+    m_cutoff = &cutoff;
 }
 
-void SemanticAnalyzer::visit(AST::CommentInstruction& node) {
-    const std::vector<ASTConstants::OperandType> semanticTemplate = {STRING, EMPTY, EMPTY};
-    int line = node.getLine();
-    if (m_semanticContext[line] == semanticTemplate) {
-        return;
-    }
-    handleAtomicInstructionError(line, semanticTemplate, node);
+std::unique_ptr<PassContext> SemanticAnalyzer::createContext() {
+    return std::make_unique<ThreadContext>();
 }
 
-
-void SemanticAnalyzer::visit(AST::CreateInstruction& node) {
-    //CASE 2 - Multiple type instruction
-    //Expected semantic structure of instruction - some operands can be of multiple types
-    const vector<unordered_set<ASTConstants::OperandType>> semanticTemplate = {
-            {TYPECONDITION},
-            {INTEGER, CHARACTER, BOOLEAN, FLOAT, MEMORYADDRESS, INSTRUCTIONADDRESS},
-            {REGISTER}
-    };
-    int line = node.getLine();
-    vector<ASTConstants::OperandType> localContext = m_semanticContext[line];
-    //Iterate over possible semantics
-    for (int i=0; i<localContext.size(); i++) {
-        //Check if every operand in the context is a part of valid operands in the template
-        if (semanticTemplate[i].find(localContext[i]) == semanticTemplate[i].end()) {
-            //Handle error if not
-            handleMultipleInstructionError(line, semanticTemplate, node);
+void SemanticAnalyzer::visitRange(AST::ASTNode* const* begin, AST::ASTNode* const* end, PassContext* context) {
+    auto& threadContext = static_cast<ThreadContext&>(*context);
+    for (auto* child = begin; child != end; ++child) {
+        auto& node = *static_cast<InstructionNode*>(*child);
+        //Ranges are in line order, so the rest of this one is past the cutoff too
+        if (m_cutoff->reached(node.getLine() - 1)) {
             return;
         }
-    }
-    //Returns successfuly if end of loop is reached
-}
-
-void SemanticAnalyzer::visit(AST::LoadInstruction& node) {
-    const std::vector<std::unordered_set<ASTConstants::OperandType>> semanticTemplate = {
-            {MEMORYADDRESS, REGISTER},
-            {REGISTER},
-            {EMPTY}
-    };
-    int line = node.getLine();
-    const auto& localContext = m_semanticContext[line];
-    for (int i=0; i < localContext.size(); i++) {
-        if (semanticTemplate[i].find(localContext[i]) == semanticTemplate[i].end()) {
-            handleMultipleInstructionError(line, semanticTemplate, node);
-            return;
+        //Build the local semantic context from the operands - an operation will never have >3 operands, and unused
+        //slots are empty for easier matching
+        OperandType localContext[MAX_OPERANDS] = {EMPTY, EMPTY, EMPTY};
+        OperandNode* localOperands[MAX_OPERANDS] = {nullptr, nullptr, nullptr};
+        for (auto* operand : node.getChildren()) {
+            auto* operandNode = static_cast<OperandNode*>(operand);
+            localContext[operandNode->getPos()] = operandNode->getOperandType();
+            localOperands[operandNode->getPos()] = operandNode;
+        }
+        //Check against the signature, only recording an error if it doesn't match
+        if (!matchesSignature(packContext(localContext), node.getInstructionType())) {
+            instructionError(threadContext.diagnostics, node.getLine(), localContext, node.getInstructionType(), [&localOperands](int pos) {
+                if (localOperands[pos] == nullptr) {
+                    return pair<string_view, OperandValue>();
+                }
+                return make_pair(localOperands[pos]->getNodeView(), localOperands[pos]->getValue());
+            });
+            m_cutoff->update(threadContext.diagnostics);
         }
     }
 }
 
-void SemanticAnalyzer::visit(AST::StoreInstruction& node) {
-    const std::vector<std::unordered_set<ASTConstants::OperandType>> semanticTemplate = {
-            {REGISTER},
-            {MEMORYADDRESS, REGISTER},
-            {EMPTY}
-    };
-    int line = node.getLine();
-    const auto& localContext = m_semanticContext[line];
-    for (int i=0; i < localContext.size(); i++) {
-        if (semanticTemplate[i].find(localContext[i]) == semanticTemplate[i].end()) {
-            handleMultipleInstructionError(line, semanticTemplate, node);
-            return;
-        }
-    }
+void SemanticAnalyzer::mergeContext(PassContext* context) {
+    //Every line belongs to one thread, so the buffers never overlap
+    m_threadDiagnostics.push_back(std::move(static_cast<ThreadContext&>(*context).diagnostics));
 }
 
-void SemanticAnalyzer::visit(AST::JumpInstruction& node) {
-    const std::vector<std::unordered_set<ASTConstants::OperandType>> semanticTemplate = {
-            {JUMPCONDITION},
-            {INSTRUCTIONADDRESS, REGISTER},
-            {EMPTY}
-    };
-    int line = node.getLine();
-    const auto& localContext = m_semanticContext[line];
-    for (int i=0; i < localContext.size(); i++) {
-        if (semanticTemplate[i].find(localContext[i]) == semanticTemplate[i].end()) {
-            handleMultipleInstructionError(line, semanticTemplate, node);
-            return;
-        }
+void SemanticAnalyzer::finish(vector<DiagnosticBuffer>& diagnostics) {
+    for (auto& buffer : m_threadDiagnostics) {
+        diagnostics.push_back(std::move(buffer));
     }
+    m_threadDiagnostics.clear();
 }
 
-void SemanticAnalyzer::visit(AST::CallInstruction& node) {
-    const std::vector<std::unordered_set<ASTConstants::OperandType>> semanticTemplate = {
-            {INSTRUCTIONADDRESS, REGISTER},
-            {EMPTY},
-            {EMPTY}
-    };
-    int line = node.getLine();
-    const auto& localContext = m_semanticContext[line];
-    for (int i=0; i < localContext.size(); i++) {
-        if (semanticTemplate[i].find(localContext[i]) == semanticTemplate[i].end()) {
-            handleMultipleInstructionError(line, semanticTemplate, node);
-            return;
-        }
+void SemanticAnalyzer::analyzeProgram(const AST::Program& program, DiagnosticCutoff& cutoff, vector<DiagnosticBuffer>& diagnostics) {
+    //Operand types are stored with each instruction, so no semantic context is needed. Every entry is checked in a
+    //branch-free loop the compiler can vectorize (blank entries have no operands and always match)
+    int numInstructions = static_cast<int>(program.size());
+    vector<uint8_t> failing(numInstructions);
+    #pragma omp parallel for simd schedule(static) default(none) shared(program, numInstructions, failing)
+    for (int i=0; i<numInstructions; i++) {
+        OperandType context[MAX_OPERANDS] = {program.getOperandType(i, 0), program.getOperandType(i, 1), program.getOperandType(i, 2)};
+        failing[i] = !matchesSignature(packContext(context), program.getOpcode(i));
     }
-}
 
-void SemanticAnalyzer::visit(AST::PrintInstruction& node) {
-    const std::vector<std::unordered_set<ASTConstants::OperandType>> semanticTemplate = {
-            {STRING, NEWLINE},
-            {EMPTY},
-            {EMPTY}
-    };
-    int line = node.getLine();
-    const auto& localContext = m_semanticContext[line];
-    for (int i=0; i < localContext.size(); i++) {
-        if (semanticTemplate[i].find(localContext[i]) == semanticTemplate[i].end()) {
-            handleMultipleInstructionError(line, semanticTemplate, node);
-            return;
+    //Errors are only recorded for the failing entries, each thread into its own buffer
+    vector<DiagnosticBuffer> threadDiagnostics(omp_get_max_threads());
+    #pragma omp parallel default(none) shared(program, numInstructions, failing, threadDiagnostics, cutoff)
+    {
+        DiagnosticBuffer& buffer = threadDiagnostics[omp_get_thread_num()];
+        #pragma omp for schedule(static)
+        for (int i=0; i<numInstructions; i++) {
+            //Entry n is on line index n
+            if (!failing[i] || cutoff.reached(i)) {
+                continue;
+            }
+            OperandType context[MAX_OPERANDS] = {program.getOperandType(i, 0), program.getOperandType(i, 1), program.getOperandType(i, 2)};
+            instructionError(buffer, program.getLine(i), context, program.getOpcode(i), [&program, i, this](int pos) {
+                return make_pair(program.getOperandView(i, pos, m_source), program.getOperandValue(i, pos));
+            });
+            cutoff.update(buffer);
         }
     }
+    for (auto& buffer : threadDiagnostics) {
+        diagnostics.push_back(std::move(buffer));
+    }
 }
 
-
-void SemanticAnalyzer::visit(AST::RegisterOperand& node) {
-    //Insert its type in the local semantic context
-    m_semanticContext[node.getLine()][node.getPos()] = node.getOperandType();
-}
-
-void SemanticAnalyzer::visit(AST::InstructionAddressOperand& node) {
-    m_semanticContext[node.getLine()][node.getPos()] = node.getOperandType();
-}
-
-void SemanticAnalyzer::visit(AST::MemoryAddressOperand& node) {
-    m_semanticContext[node.getLine()][node.getPos()] = node.getOperandType();
-}
-
-void SemanticAnalyzer::visit(AST::IntegerOperand& node) {
-    m_semanticContext[node.getLine()][node.getPos()] = node.getOperandType();
-}
-
-void SemanticAnalyzer::visit(AST::FloatOperand& node) {
-    m_semanticContext[node.getLine()][node.getPos()] = node.getOperandType();
-}
-
-void SemanticAnalyzer::visit(AST::BooleanOperand& node) {
-    m_semanticContext[node.getLine()][node.getPos()] = node.getOperandType();
-}
-
-void SemanticAnalyzer::visit(AST::CharacterOperand& node) {
-    m_semanticContext[node.getLine()][node.getPos()] = node.getOperandType();
-}
-
-void SemanticAnalyzer::visit(AST::StringOperand& node) {
-    m_semanticContext[node.getLine()][node.getPos()] = node.getOperandType();
-}
-
-void SemanticAnalyzer::visit(AST::NewlineOperand& node) {
-    m_semanticContext[node.getLine()][node.getPos()] = node.getOperandType();
+uint64_t SemanticAnalyzer::packContext(const OperandType* context) {
+    return (uint64_t(1) << context[0]) | (uint64_t(1) << (context[1] + SLOT_BITS)) | (uint64_t(1) << (context[2] + 2 * SLOT_BITS));
 }
 
-void SemanticAnalyzer::visit(AST::TypeConditionOperand& node) {
-    m_semanticContext[node.getLine()][node.getPos()] = node.getOperandType();
+bool SemanticAnalyzer::matchesSignature(uint64_t packedContext, InstructionType type) {
+    //Every operand must be one of the types its slot accepts - no bit may fall outside the signature
+    return (packedContext & ~SIGNATURE_MASKS[type]) == 0;
 }
 
-void SemanticAnalyzer::visit(AST::ShiftConditionOperand& node) {
-    m_semanticContext[node.getLine()][node.getPos()] = node.getOperandType();
-}
+void SemanticAnalyzer::instructionError(DiagnosticBuffer& diagnostics, int line, const OperandType* context, InstructionType type, const function<pair<string_view, OperandValue>(int)>& operand) {
+    //The engine writes one heading for the line, then an error per operand
+    const InstructionSet::Instruction& instruction = INSTRUCTIONS[type];
 
-void SemanticAnalyzer::visit(AST::JumpConditionOperand& node) {
-    m_semanticContext[node.getLine()][node.getPos()] = node.getOperandType();
-}
-
-void SemanticAnalyzer::handleAtomicInstructionError(int line, const std::vector<ASTConstants::OperandType> &expectedTemplate, AST::InstructionNode &node) {
-    //Create the invalid line log first
-    string errorLine = "Invalid syntax at line " + to_string(line) + ": " + m_lines[line-1] + "\n";
-    vector<ASTConstants::OperandType> localContext = m_semanticContext[line];
-    //Check every mismatched operand
-    for (int i=0; i<localContext.size(); i++) {
-        if (localContext[i] != expectedTemplate[i]) {
-            if (expectedTemplate[i] != EMPTY) {
-                //Unrecognized operand if not expecting an empty space
-                 errorLine += "Unrecognized operand '" + node.childAt(i)->getNodeValue() + "'. Expected " + enumToString(expectedTemplate[i]) + "\n\n";
-            }
-            else {
-                //Excess operand if expecting an empty space
-                errorLine += "Unexpected extra operand '" + node.childAt(i)->getNodeValue() + "'\n\n";
+    //Iterate over all given operands in the local context
+    for (int i=0; i<MAX_OPERANDS; i++) {
+        //If a local context token doesn't match any in the signature for that index
+        uint64_t expected = slotMask(instruction.operands[i]);
+        if ((expected & (uint64_t(1) << context[i])) == 0) {
+            auto [text, value] = operand(i);
+            //Excess operand if expecting an empty space (AST lines count from 1)
+            DiagnosticConstants::Code code = expected != (uint64_t(1) << EMPTY) ? DiagnosticConstants::UNRECOGNIZED_OPERAND : DiagnosticConstants::EXTRA_OPERAND;
+            Diagnostic diagnostic = Diagnostic::operand(code, line - 1, text, value);
+            if (code == DiagnosticConstants::UNRECOGNIZED_OPERAND) {
+                diagnostic.detail = expectedOperands(type, i);
             }
+            diagnostics.push_back(diagnostic);
         }
     }
-    //Add to the invalid lines map
-    #pragma omp critical
-    {
-        m_invalidLines[line] = errorLine;
-    };
 }
 
-void SemanticAnalyzer::handleMultipleInstructionError(int line, const std::vector<std::unordered_set<ASTConstants::OperandType>> &expectedTemplate, AST::InstructionNode &node) {
-    //Create the invalid line log first
-    const unordered_set<ASTConstants::OperandType> emptyTemplate = {EMPTY};
-    string errorLine = "Invalid syntax at line " + to_string(line) + ": " + m_lines[line-1] + "\n";
-    vector<ASTConstants::OperandType> localContext = m_semanticContext[line];
-
-    //Iterate over all given operands in the local context
-    for (int i=0; i<localContext.size(); i++) {
-        //If a local context token doesn't match any in the template for that index
-        if (expectedTemplate[i].find(localContext[i]) == expectedTemplate[i].end()) {
-            if (expectedTemplate[i] != emptyTemplate) {
-                errorLine += "Unrecognized operand '" + node.childAt(i)->getNodeValue() + "'. Expected ";
-                //Add all possible expected operands
-                for (auto it = expectedTemplate[i].begin(); it != expectedTemplate[i].end(); ++it) {
-                    if (it != expectedTemplate[i].begin()) {
-                        errorLine += " or ";
+string_view SemanticAnalyzer::expectedOperands(InstructionType type, int pos) {
+    //Every slot's list of expected operands, built once - diagnostics point into it
+    static const array<array<string, MAX_OPERANDS>, NONE + 1> expectedLists = [] {
+        array<array<string, MAX_OPERANDS>, NONE + 1> lists;
+        for (size_t i=0; i<lists.size(); i++) {
+            for (int j=0; j<MAX_OPERANDS; j++) {
+                const SlotSignature& slotSignature = INSTRUCTIONS[i].operands[j];
+                for (int k=0; k<slotSignature.numTypes; k++) {
+                    if (k != 0) {
+                        lists[i][j] += " or ";
                     }
-                    errorLine += enumToString(*it);
+                    lists[i][j] += enumToString(slotSignature.types[k]);
                 }
-                errorLine += "\n\n";
-            }
-            else {
-                //Excess operand if expecting an empty space
-                errorLine += "Unexpected extra operand '" + node.childAt(i)->getNodeValue() + "'\n\n";
             }
         }
-    }
-    //Add to the invalid lines map
-    #pragma omp critical
-    {
-        m_invalidLines[line] = errorLine;
-    };
+        return lists;
+    }();
+    return expectedLists[type][pos];
 }
 
 string SemanticAnalyzer::enumToString(OperandType type) {
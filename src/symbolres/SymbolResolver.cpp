@@ -1,94 +1,110 @@
 #include "symbolres/SymbolResolver.h"
 
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
+#include <algorithm>
+#include <omp.h>
 
 using namespace std;
 
-bool SymbolResolver::resolveSymbols(unordered_map<string, pair<string, int>> &symbolTable, PT::PTNode *parseTree, string &errorMessage, const std::vector<std::string>& codeLines) {
-    //Perform main steps of symbol resolution
-    buildSymbolTable(symbolTable, parseTree, codeLines);
-    bindSymbols(symbolTable, parseTree, codeLines);
+//Defined ahead of the three resolution paths, its only callers
+template <typename Bind>
+bool SymbolResolver::bindReferences(SymbolTable &symbolTable, const LabelTable& labelTable, const TokenStream& tokens, DiagnosticEngine& diagnostics, Bind&& bindReference) {
+    //The parser already collected the declarations, so the table is filled without looking at the program. It keeps
+    //the first declaration of each label in line order - the rest are reported
+    symbolTable.reset(tokens.numSymbols());
+    vector<SymbolTable::Duplicate> duplicates;
+    symbolTable.declare(labelTable.definitions, duplicates);
 
-    //Concatenate invalidLines string from all errors accumulated out of order
-    string invalidLines;
-    for (const auto& pair : m_invalidLinesMap) {
-        invalidLines += pair.second;
-    }
-
-    //Return false if invalidLines not empty (errors encountered)
-    if (!invalidLines.empty()) {
-        errorMessage = invalidLines;
-        return false;
-    }
-    return true;
-}
-
-void SymbolResolver::buildSymbolTable(unordered_map<string, pair<string, int>> &symbolTable, PT::PTNode *parseTree, const std::vector<std::string>& codeLines) {
-    int parseTreeSize = parseTree->getNumChildren();
-    //Look for label declarations in parse tree and add to the label table
-    //Iterate over all children in the loop leveraging OMP
-    #pragma omp parallel for schedule(dynamic) default(none) shared(parseTree, parseTreeSize, symbolTable, codeLines)
-    for (int i=0; i<parseTreeSize; i++) {
-        //Iterate over every child in the root node
-        if(parseTree->childAt(i)->getNodeValue() == "label") {
-            string labelValue = parseTree->childAt(i)->childAt(0)->childAt(0)->getNodeValue();
-            //Check if label is already declared in the symbol table
-            auto itr = symbolTable.find(labelValue);
-            if (itr != symbolTable.end()) {
-                //Critical section as modifying STL container
-                #pragma omp critical
-                {
-                    m_invalidLinesMap[i] = "\nLabel error at line " + to_string(i+1) + ": " +  codeLines[i] + "\nDuplicate label " + labelValue + " already declared at line " + to_string(itr->second.second+1) + "\n";
+    //Patch every use (declarations included) with its instruction address, in one pass over the backpatch list
+    //Each operand belongs to one use, and the table is only read, so nothing needs locking
+    const vector<LabelReference>& uses = labelTable.uses;
+    int numUses = static_cast<int>(uses.size());
+    vector<char> undefined(numUses, 0);
+    //Once the error limit is known to be reached, the remaining uses are skipped (the program won't be compiled)
+    DiagnosticCutoff cutoff;
+    cutoff.reset(diagnostics.remaining());
+    #pragma omp parallel default(none) shared(uses, numUses, symbolTable, undefined, bindReference, cutoff)
+    {
+        //Lines with an undefined label this thread has found, and the last of them
+        size_t numUndefinedLines = 0;
+        int lastUndefinedLine = -1;
+        #pragma omp for schedule(static)
+        for (int i=0; i<numUses; i++) {
+            const LabelReference& reference = uses[i];
+            if (cutoff.reached(reference.line)) {
+                continue;
+            }
+            int declaredLine = symbolTable.find(reference.symbol);
+            if (declaredLine == SymbolTable::UNDECLARED) {
+                undefined[i] = 1;
+                if (reference.line != lastUndefinedLine) {
+                    lastUndefinedLine = reference.line;
+                    cutoff.update(++numUndefinedLines, lastUndefinedLine);
                 }
             }
-            //Critical section as modifying STL container
-            #pragma omp critical
-            {
-                //Include the label (child of instruction child) and corresponding address (root node index + 1)
-                symbolTable.emplace(labelValue, make_pair("i[" + to_string(i+1) +  "]", i));
+            else {
+                bindReference(reference, static_cast<uint32_t>(declaredLine + 1));
             }
         }
     }
-}
 
-void SymbolResolver::bindSymbols(unordered_map<string, pair<string, int>> &symbolTable, PT::PTNode *parseTree, const std::vector<std::string>& codeLines) {
-    int parseTreeSize = parseTree->getNumChildren();
-    #pragma omp parallel for schedule(dynamic) default(none) shared(parseTree, parseTreeSize, symbolTable, codeLines)
-    for (int i=0; i<parseTreeSize; i++) {
-        //Get the node pointer for the line and size (frequent access)
-        PT::PTNode* lineNode = parseTree->childAt(i);
-        int lineSize = lineNode->getNumChildren();
-        for(int j=0; j<lineSize; j++) {
-            //If the child is an operand node (L2 nodes are atomic with only one child)
-            if (lineNode->childAt(j)->childAt(0)->getNodeType() == PTConstants::NodeType::OPERAND) {
-                //Cast to operandNode to check type
-                auto labelNode = dynamic_cast<PT::OperandNode*>(lineNode->childAt(j)->childAt(0));
-                //Check if successful cast and type is a label
-                if (labelNode != nullptr && labelNode->getOperandType() == PTConstants::OperandType::LABEL) {
-                    //Decision logic - check if a part of symbolTable
-                    auto itr = symbolTable.find(labelNode->getNodeValue());
-                    if (itr == symbolTable.end()) {
-                        //Throw an undefined error if not found in symbol table
-                        //Modifying section - use critical
-                        #pragma omp critical
-                        {
-                            m_invalidLinesMap[i] = "\nLabel error at line " + to_string(i+1) + ": " +  codeLines[i] + "\nUndefined label " + labelNode->getNodeValue() + "\n";
-                        }
-                    }
-                    else {
-                        //Change operand value and operand type to instruction address
-                        //Tree is NOT thread safe writing - critical section
-                        #pragma omp critical
-                        {
-                            labelNode->setNodeValue(itr->second.first);
-                            labelNode->setOperandType(PTConstants::OperandType::INSTRUCTIONADDRESS);
-                        }
-                    }
-                }
+    //Both lists go to the engine in line order. A duplicate's line declares its label, so it is never undefined too
+    vector<DiagnosticBuffer> buffers(2);
+    DiagnosticBuffer& duplicateLabels = buffers[0];
+    duplicateLabels.reserve(duplicates.size());
+    for (const auto& duplicate : duplicates) {
+        duplicateLabels.push_back({DiagnosticConstants::DUPLICATE_LABEL, duplicate.line, tokens.symbolName(duplicate.symbol), {}, duplicate.declaredLine});
+    }
+    stable_sort(duplicateLabels.begin(), duplicateLabels.end(), [](const Diagnostic& a, const Diagnostic& b) {
+        return a.line < b.line;
+    });
+    //Uses are in line order - only the last undefined label on a line is reported
+    DiagnosticBuffer& undefinedLabels = buffers[1];
+    for (int i=0; i<numUses; i++) {
+        if (undefined[i]) {
+            const LabelReference& reference = uses[i];
+            Diagnostic diagnostic{DiagnosticConstants::UNDEFINED_LABEL, reference.line, tokens.symbolName(reference.symbol), {}};
+            if (!undefinedLabels.empty() && undefinedLabels.back().line == reference.line) {
+                undefinedLabels.back() = diagnostic;
+            }
+            else {
+                undefinedLabels.push_back(diagnostic);
             }
         }
     }
+    bool resolved = duplicateLabels.empty() && undefinedLabels.empty();
+    diagnostics.report(buffers);
+    return resolved;
+}
+
+bool SymbolResolver::resolveSymbols(SymbolTable &symbolTable, PT::ParseTree *parseTree, const LabelTable& labelTable, const TokenStream& tokens, DiagnosticEngine& diagnostics) {
+    //Root children are lines, and each holds one conjunction node per operand with the operand under it
+    PT::PTNode* root = parseTree->getRoot();
+    return bindReferences(symbolTable, labelTable, tokens, diagnostics, [root](const LabelReference& reference, uint32_t address) {
+        auto labelNode = static_cast<PT::OperandNode*>(root->childAt(reference.line)->childAt(reference.pos)->childAt(0));
+        //Change operand value and operand type to instruction address (the node keeps the label text)
+        labelNode->setOperandType(PTConstants::OperandType::INSTRUCTIONADDRESS);
+        OperandValue value;
+        value.payload.address = address;
+        value.label = true;
+        labelNode->setValue(value);
+    });
+}
+
+bool SymbolResolver::resolveLabels(SymbolTable &symbolTable, const LabelTable& labelTable, const TokenStream& tokens, DiagnosticEngine& diagnostics) {
+    return bindReferences(symbolTable, labelTable, tokens, diagnostics, [](const LabelReference& reference, uint32_t address) {
+        //The node keeps the label text - its i[n] form is only formatted when printed
+        OperandValue value;
+        value.payload.address = address;
+        value.label = true;
+        reference.operand->setValue(value);
+    });
+}
+
+bool SymbolResolver::resolveLabels(SymbolTable &symbolTable, const LabelTable& labelTable, AST::Program& program, const TokenStream& tokens, DiagnosticEngine& diagnostics) {
+    return bindReferences(symbolTable, labelTable, tokens, diagnostics, [&program](const LabelReference& reference, uint32_t address) {
+        program.resolveAddress(reference.line, reference.pos, address);
+    });
 }
@@ -0,0 +1,27 @@
+#include "symbolres/SymbolTable.h"
+
+#include <vector>
+
+using namespace std;
+
+void SymbolTable::reset(size_t numSymbols) {
+    m_lines.assign(numSymbols, UNDECLARED);
+    m_numDeclared = 0;
+}
+
+void SymbolTable::declare(const vector<vector<Declaration>>& declarationLists, vector<Duplicate>& duplicates) {
+    //Declaring is one array write per label instruction, far cheaper than splitting the lists between threads, so
+    //the lists are walked in order and the first declaration of each label is the one kept
+    for (const auto& declarationList : declarationLists) {
+        for (const Declaration& declaration : declarationList) {
+            int& declaredLine = m_lines[declaration.symbol];
+            if (declaredLine == UNDECLARED) {
+                declaredLine = declaration.line;
+                m_numDeclared++;
+            }
+            else {
+                duplicates.push_back({declaration.symbol, declaration.line, declaredLine});
+            }
+        }
+    }
+}
@@ -6,6 +6,7 @@ import argparse
 # Set up argument parsing
 parser = argparse.ArgumentParser(description='Generate and run a StartASM stress test.')
 parser.add_argument('num_lines', type=int, help='Number of lines to include in the stress test file')
+parser.add_argument('--lexer', choices=['dfa', 'regex'], default='dfa', help='Operand classifier to benchmark the lexer with')
 args = parser.parse_args()
 
 # Define the StartASM executable path
@@ -15,7 +16,7 @@ executable_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..',
 stress_test_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'StressTest.sasm')
 
 # Command-line arguments
-cli_args = ["compile", stress_test_path, "--timings"]
+cli_args = ["compile", stress_test_path, "--timings", "--lexer=" + args.lexer]
 
 # Define some basic parameters
 num_lines = args.num_lines  # Target number of lines for the stress test file
@@ -0,0 +1,94 @@
+import random
+import os
+import subprocess
+import argparse
+import sys
+
+# Set up argument parsing
+parser = argparse.ArgumentParser(description='Differential test of the DFA operand classifier against the regex classifier.')
+parser.add_argument('num_lines', type=int, help='Number of lines to include in the test file')
+parser.add_argument('--seed', type=int, default=None, help='Random seed for reproducible test files')
+args = parser.parse_args()
+random.seed(args.seed)
+
+# Define the StartASM executable path
+executable_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'startasm')
+
+# Define the full path for the test file
+test_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'LexerTest.sasm')
+
+# Define some basic parameters
+num_lines = args.num_lines  # Target number of lines for the test file
+keywords = ['move', 'add', 'to', 'with', 'if', 'left', 'greater', 'integer', 'memory']
+alphabet = 'rmi<>[]-.\'0123456789truefalsxyz"!~'
+
+
+# Random digit strings of varying length (including leading zeros and more than 10 digits)
+def digits(low=0, high=12):
+    return ''.join(random.choice('0123456789') for _ in range(random.randint(low, high)))
+
+
+# Token generators covering every operand template and the near misses around them
+generators = [
+    lambda: 'r' + digits(),
+    lambda: 'm<' + digits() + '>',
+    lambda: 'i[' + digits() + ']',
+    lambda: random.choice(['', '-']) + digits(1, 12),
+    lambda: random.choice(['', '-']) + digits() + '.' + digits(),
+    lambda: random.choice(['true', 'false', 'tru', 'falsey', 'True', '1', '0', '-0']),
+    lambda: random.choice(alphabet),
+    lambda: '\'' + ''.join(random.choice(alphabet) for _ in range(random.randint(0, 6))) + '\'',
+    lambda: ''.join(random.choice(alphabet) for _ in range(random.randint(1, 8))),
+    lambda: random.choice(keywords),
+]
+
+# Create the test file
+with open(test_path, 'w') as file:
+    for _ in range(num_lines):
+        choice = random.random()
+        if choice < 0.1:
+            # Comments and prints, which take the rest of the line as a string operand
+            body = ''.join(random.choice(alphabet + ' ') for _ in range(random.randint(0, 10)))
+            line = random.choice(['comment', 'print']) + random.choice([' ', '  ']) + random.choice(['"' + body + '"', body, 'newline'])
+        elif choice < 0.15:
+            line = ''
+        else:
+            line = ' '.join(random.choice(generators)() for _ in range(random.randint(1, 6)))
+        file.write(line + '\n')
+
+# Change the working directory to the root directory
+root_dir = os.path.dirname(os.path.abspath(__file__))
+os.chdir(root_dir)
+
+# Run the lexer with both classifiers and compare the token streams
+results = {}
+for mode in ['regex', 'dfa']:
+    result = subprocess.run([executable_path, "compile", test_path, "--tokens", "--lexer=" + mode], capture_output=True, text=True)
+    results[mode] = result.stdout.splitlines()
+
+# Remove the test file
+try:
+    os.remove(test_path)
+except FileNotFoundError:
+    print("File not found error deleting test file")
+except PermissionError:
+    print("Permission error deleting test file")
+except Exception as e:
+    print(f"Other error deleting test file: {e}")
+
+# Print every mismatching line
+mismatches = 0
+for regex_line, dfa_line in zip(results['regex'], results['dfa']):
+    if regex_line != dfa_line:
+        mismatches += 1
+        print("regex: " + regex_line)
+        print("dfa:   " + dfa_line)
+if len(results['regex']) != len(results['dfa']):
+    mismatches += 1
+    print("Output length differs between classifiers")
+
+if mismatches == 0:
+    print(f"Lexer test passed: {num_lines} lines classified identically")
+else:
+    print(f"Lexer test failed: {mismatches} mismatching lines")
+    sys.exit(1)
@@ -0,0 +1,124 @@
+import random
+import os
+import re
+import subprocess
+import argparse
+import statistics
+
+# Set up argument parsing
+parser = argparse.ArgumentParser(description='Benchmark the throughput of the StartASM front-end stages on a generated file.')
+parser.add_argument('num_lines', type=int, help='Number of lines to include in the benchmark file')
+parser.add_argument('--stage', choices=['parse', 'buildAST', 'analysis'], nargs='+', default=['parse'], help='Stages to time')
+parser.add_argument('--threads', type=int, nargs='+', default=None, help='OpenMP thread counts to run with (defaults to the environment)')
+parser.add_argument('--runs', type=int, default=5, help='Number of compiler runs to take the median of')
+parser.add_argument('--errors', type=float, default=0.0, help='Fraction of lines with a syntax error (exercises error reporting)')
+parser.add_argument('--seed', type=int, default=None, help='Random seed for reproducible benchmark files')
+parser.add_argument('--executable', default=None, help='StartASM executable to benchmark (defaults to the one in the repo root)')
+args = parser.parse_args()
+random.seed(args.seed)
+
+# Define the StartASM executable path
+executable_path = args.executable or os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'startasm')
+
+# Define the full path for the benchmark file
+benchmark_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'ParserBenchmark.sasm')
+
+# Define some basic parameters
+registers = ['r' + str(i) for i in range(10)]
+jump_conditions = ['greater', 'less', 'equal', 'unequal', 'zero', 'nonzero', 'unconditional']
+types = ['integer', 'float', 'boolean', 'character']
+
+
+# One generator per instruction shape, so every parsing template is exercised
+def reg():
+    return random.choice(registers)
+
+
+generators = [
+    lambda: f"move {reg()} to {reg()}",
+    lambda: f"load m<{random.randint(0, 1000)}> to {reg()}",
+    lambda: f"store {reg()} to m<{random.randint(0, 1000)}>",
+    lambda: f"create integer {random.randint(-1000, 1000)} to {reg()}",
+    lambda: f"cast {random.choice(types)} {reg()}",
+    lambda: f"{random.choice(['add', 'sub', 'multiply', 'divide'])} {reg()} with {reg()} to {reg()}",
+    lambda: f"{random.choice(['or', 'and'])} {reg()} with {reg()}",
+    lambda: f"not {reg()}",
+    lambda: f"shift {random.choice(['left', 'right'])} {reg()} by {reg()}",
+    lambda: f"compare {reg()} with {reg()}",
+    lambda: f"jump if {random.choice(jump_conditions)} to i[1]",
+    lambda: "call to i[1]",
+    lambda: f"push {reg()}",
+    lambda: f"pop to {reg()}",
+    lambda: f"input {random.choice(types)} to {reg()}",
+    lambda: f"output {reg()}",
+    lambda: "print \"benchmark\"",
+    lambda: "comment \"benchmark\"",
+    lambda: "return",
+]
+
+# Lines with a syntax error in one of the levels (instruction, conjunction, operand, excess tokens)
+error_generators = [
+    lambda: f"mov {reg()} to {reg()}",
+    lambda: f"move {reg()} into {reg()}",
+    lambda: f"move {reg()} to",
+    lambda: f"move {reg()} to {reg()} {reg()}",
+]
+
+# Timing report header of each stage, and the flags that make the compiler run it
+stages = {
+    "parse": ("Compiler: Parsing code", []),
+    "buildAST": ("Compiler: Building AST", ["--parsetree"]),
+    "analysis": ("Compiler: Analyzing semantics and checking address scopes", []),
+}
+
+# Create the benchmark file
+with open(benchmark_path, 'w') as file:
+    for _ in range(args.num_lines - 1):
+        if random.random() < args.errors:
+            file.write(random.choice(error_generators)() + '\n')
+        else:
+            file.write(random.choice(generators)() + '\n')
+    file.write("stop\n")
+
+# Change the working directory to the root directory
+root_dir = os.path.dirname(os.path.abspath(__file__))
+os.chdir(root_dir)
+
+# Run every stage at every thread count, pulling the stage time out of the timing report
+thread_counts = args.threads or [None]
+results = {}
+for stage in args.stage:
+    header, flags = stages[stage]
+    for threads in thread_counts:
+        env = dict(os.environ, OMP_NUM_THREADS=str(threads)) if threads else None
+        times = []
+        for _ in range(args.runs):
+            result = subprocess.run([executable_path, "compile", benchmark_path, "--timings"] + flags, capture_output=True, text=True, env=env)
+            match = re.search(re.escape(header) + r"\nTime taken: ([0-9.]+)", result.stdout)
+            if match is None:
+                print(f"Could not find the {stage} stage timing in the compiler output")
+                break
+            times.append(float(match.group(1)))
+        if times:
+            results[(stage, threads)] = (statistics.median(times), len(times))
+
+# Remove the benchmark file
+try:
+    os.remove(benchmark_path)
+except FileNotFoundError:
+    print("File not found error deleting benchmark file")
+except PermissionError:
+    print("Permission error deleting benchmark file")
+except Exception as e:
+    print(f"Other error deleting benchmark file: {e}")
+
+# Report medians, with speedup relative to the first thread count
+for stage in args.stage:
+    baseline = results.get((stage, thread_counts[0]))
+    for threads in thread_counts:
+        if (stage, threads) not in results:
+            continue
+        median, runs = results[(stage, threads)]
+        speedup = f", {baseline[0] / median:.2f}x vs {thread_counts[0]} threads" if threads and baseline else ""
+        thread_info = f", {threads} threads" if threads else ""
+        print(f"{stage}: {args.num_lines} lines{thread_info}, median {median:.4f}s over {runs} runs ({args.num_lines / median / 1e6:.2f}M lines/s{speedup})")